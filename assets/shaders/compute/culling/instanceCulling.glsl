@@ -0,0 +1,150 @@
+#type compute
+#version 460 core
+/*
+ * A compute shader to cull static mesh instances. Each invocation tests one
+ * instance against the camera frustum and the previous frame's hierarchical
+ * depth buffer. Visible instances are compacted into a second entity buffer
+ * and counted into the instance count of their indirect draw command.
+ * Instances come from either the per-frame or the retained entity buffer.
+ */
+
+#define GROUP_SIZE 64
+
+layout(local_size_x = GROUP_SIZE, local_size_y = 1) in;
+
+struct EntityData
+{
+  vec4 u_transformRows[3]; // The first three rows of the affine model matrix.
+  uvec4 u_ids; // The entity ID + 1 (x), the material ID (y) and the instance flags (z). W is unused.
+};
+
+struct InstanceJob
+{
+  vec4 boundsMin; // Local space AABB minimum (x, y, z). w is unused.
+  vec4 boundsMax; // Local space AABB maximum (x, y, z). w is unused.
+  uvec4 indices; // Entity index (x), draw command index (y) and retained (z). w is unused.
+};
+
+struct DrawCommand
+{
+  uint count;
+  uint instanceCount;
+  uint first;
+  uint baseInstance;
+};
+
+layout(std140, binding = 1) uniform InstanceCullingBlock
+{
+  mat4 u_previousViewProj;
+  vec4 u_frustumPlanes[6]; // World space frustum normals, signed distance is packed in the w component.
+  uvec4 u_cullingSettings; // Number of instances (x), Hi-Z culling enabled (y), number of valid Hi-Z mips (z) and frustum culling enabled (w).
+};
+
+// The previous frame's hierarchical depth buffer (farthest depth).
+layout(binding = 0) uniform sampler2D hiZ;
+
+layout(std430, binding = 0) readonly buffer JobBuffer
+{
+  InstanceJob jobs[];
+};
+
+layout(std140, binding = 2) readonly buffer EntityBlock
+{
+  EntityData u_entityData[];
+};
+
+layout(std140, binding = 3) writeonly buffer VisibleEntityBlock
+{
+  EntityData visibleEntityData[];
+};
+
+layout(std430, binding = 4) buffer CommandBuffer
+{
+  DrawCommand commands[];
+};
+
+layout(std140, binding = 5) readonly buffer RetainedEntityBlock
+{
+  EntityData u_retainedEntityData[];
+};
+
+bool boxInFrustum(vec3 center, vec3 extents)
+{
+  for (uint i = 0; i < 6; i++)
+  {
+    const float r = dot(extents, abs(u_frustumPlanes[i].xyz));
+    if (dot(vec4(center, 1.0), u_frustumPlanes[i]) + r < 0.0)
+      return false;
+  }
+
+  return true;
+}
+
+// Project the box with the previous frame's camera and compare the nearest
+// depth of the box against the farthest depth in the Hi-Z texels it covers.
+bool boxOccluded(vec3 center, vec3 extents)
+{
+  vec3 ndcMin = vec3(1.0);
+  vec3 ndcMax = vec3(-1.0);
+  for (uint i = 0; i < 8; i++)
+  {
+    const vec3 corner = center + extents * vec3((i & 1u) != 0u ? 1.0 : -1.0,
+                                                (i & 2u) != 0u ? 1.0 : -1.0,
+                                                (i & 4u) != 0u ? 1.0 : -1.0);
+    const vec4 clip = u_previousViewProj * vec4(corner, 1.0);
+
+    // Crosses the previous near plane, can't be tested.
+    if (clip.w <= 0.0)
+      return false;
+
+    const vec3 ndc = clip.xyz / clip.w;
+    ndcMin = min(ndcMin, ndc);
+    ndcMax = max(ndcMax, ndc);
+  }
+
+  const vec2 uvMin = clamp(0.5 * ndcMin.xy + 0.5, 0.0, 1.0);
+  const vec2 uvMax = clamp(0.5 * ndcMax.xy + 0.5, 0.0, 1.0);
+  const float boxDepth = 0.5 * ndcMin.z + 0.5;
+
+  // Pick the mip where the box covers at most 2x2 texels.
+  const vec2 size = (uvMax - uvMin) * vec2(textureSize(hiZ, 0).xy);
+  float mip = ceil(log2(max(max(size.x, size.y), 1.0)));
+  mip = clamp(mip, 0.0, float(u_cullingSettings.z - 1u));
+
+  const float d0 = textureLod(hiZ, vec2(uvMin.x, uvMin.y), mip).r;
+  const float d1 = textureLod(hiZ, vec2(uvMax.x, uvMin.y), mip).r;
+  const float d2 = textureLod(hiZ, vec2(uvMin.x, uvMax.y), mip).r;
+  const float d3 = textureLod(hiZ, vec2(uvMax.x, uvMax.y), mip).r;
+  const float maxDepth = max(max(d0, d1), max(d2, d3));
+
+  return boxDepth > maxDepth;
+}
+
+void main()
+{
+  const uint invoke = gl_GlobalInvocationID.x;
+  if (invoke >= u_cullingSettings.x)
+    return;
+
+  const InstanceJob job = jobs[invoke];
+  const EntityData entity = job.indices.z != 0u ? u_retainedEntityData[job.indices.x]
+                                                : u_entityData[job.indices.x];
+
+  // World space AABB of the instance.
+  const mat4 transform = transpose(mat4(entity.u_transformRows[0], entity.u_transformRows[1],
+                                        entity.u_transformRows[2], vec4(0.0, 0.0, 0.0, 1.0)));
+  const vec3 localCenter = 0.5 * (job.boundsMax.xyz + job.boundsMin.xyz);
+  const vec3 localExtents = 0.5 * (job.boundsMax.xyz - job.boundsMin.xyz);
+  const vec3 center = (transform * vec4(localCenter, 1.0)).xyz;
+  const vec3 extents = mat3(abs(transform[0].xyz), abs(transform[1].xyz), abs(transform[2].xyz)) * localExtents;
+
+  if (u_cullingSettings.w != 0u && !boxInFrustum(center, extents))
+    return;
+
+  if (u_cullingSettings.y != 0u && boxOccluded(center, extents))
+    return;
+
+  // Append the instance to the draw command.
+  const uint slot = atomicAdd(commands[job.indices.y].instanceCount, 1u);
+  visibleEntityData[commands[job.indices.y].baseInstance + slot] = entity;
+}
@@ -0,0 +1,126 @@
+#type compute
+#version 460 core
+/*
+ * A compute shader to cull meshlets. Each work group handles the meshlets of a
+ * single mesh instance and writes one indirect draw command per meshlet.
+ * Culled meshlets get an empty draw command.
+ */
+
+#define GROUP_SIZE 64
+
+layout(local_size_x = GROUP_SIZE, local_size_y = 1) in;
+
+struct EntityData
+{
+  vec4 u_transformRows[3]; // The first three rows of the affine model matrix.
+  uvec4 u_ids; // The entity ID + 1 (x), the material ID (y) and the instance flags (z). W is unused.
+};
+
+struct Meshlet
+{
+  vec4 boundingSphere; // Center (x, y, z) and radius (w).
+  vec4 coneAxisCutoff; // Cone axis (x, y, z) and cutoff (w). Cutoff above 1 disables cone culling.
+  uvec4 drawRange; // First index (x) and number of indices (y). z and w are unused.
+};
+
+struct ClusterJob
+{
+  uint meshletOffset;
+  uint numMeshlets;
+  uint entityIndex;
+  uint commandOffset;
+};
+
+struct DrawCommand
+{
+  uint count;
+  uint instanceCount;
+  uint first;
+  uint baseInstance;
+};
+
+// Camera specific uniforms.
+layout(std140, binding = 0) uniform CameraBlock
+{
+  mat4 u_viewMatrix;
+  mat4 u_projMatrix;
+  mat4 u_invViewProjMatrix;
+  vec3 u_camPosition;
+  vec4 u_nearFar; // Near plane (x), far plane (y). z and w are unused.
+};
+
+layout(std140, binding = 1) uniform ClusterCullingBlock
+{
+  vec4 u_frustumPlanes[6]; // World space frustum normals, signed distance is packed in the w component.
+  uvec4 u_cullingSettings; // Number of jobs (x). Y, z and w are unused.
+};
+
+layout(std140, binding = 0) readonly buffer MeshletBuffer
+{
+  Meshlet meshlets[];
+};
+
+layout(std430, binding = 1) readonly buffer JobBuffer
+{
+  ClusterJob jobs[];
+};
+
+layout(std140, binding = 2) readonly buffer EntityBlock
+{
+  EntityData u_entityData[];
+};
+
+layout(std430, binding = 3) writeonly buffer CommandBuffer
+{
+  DrawCommand commands[];
+};
+
+bool sphereInFrustum(vec3 center, float radius)
+{
+  for (uint i = 0; i < 6; i++)
+  {
+    if (dot(vec4(center, 1.0), u_frustumPlanes[i]) + radius < 0.0)
+      return false;
+  }
+
+  return true;
+}
+
+void main()
+{
+  if (gl_WorkGroupID.x >= u_cullingSettings.x)
+    return;
+
+  const ClusterJob job = jobs[gl_WorkGroupID.x];
+  const EntityData entity = u_entityData[job.entityIndex];
+  const mat4 transform = transpose(mat4(entity.u_transformRows[0], entity.u_transformRows[1],
+                                        entity.u_transformRows[2], vec4(0.0, 0.0, 0.0, 1.0)));
+  const mat3 normalMatrix = transpose(inverse(mat3(transform)));
+  const float scale = max(length(transform[0].xyz), max(length(transform[1].xyz),
+                          length(transform[2].xyz)));
+
+  for (uint i = gl_LocalInvocationIndex; i < job.numMeshlets; i += GROUP_SIZE)
+  {
+    const Meshlet meshlet = meshlets[job.meshletOffset + i];
+
+    const vec3 center = (transform * vec4(meshlet.boundingSphere.xyz, 1.0)).xyz;
+    const float radius = meshlet.boundingSphere.w * scale;
+
+    bool visible = sphereInFrustum(center, radius);
+
+    // Backfacing cone test against the bounding sphere.
+    if (visible && meshlet.coneAxisCutoff.w <= 1.0)
+    {
+      const vec3 axis = normalize(normalMatrix * meshlet.coneAxisCutoff.xyz);
+      const vec3 view = center - u_camPosition;
+      visible = dot(view, axis) < meshlet.coneAxisCutoff.w * length(view) + radius;
+    }
+
+    DrawCommand command;
+    command.count = visible ? meshlet.drawRange.y : 0u;
+    command.instanceCount = visible ? 1u : 0u;
+    command.first = meshlet.drawRange.x;
+    command.baseInstance = job.entityIndex;
+    commands[job.commandOffset + i] = command;
+  }
+}
@@ -0,0 +1,53 @@
+#type compute
+#version 460 core
+/*
+ * A compute shader to find the minimum and maximum depth of the visible
+ * geometry in the full resolution mip of the hierarchical z buffer. Used to
+ * fit the shadow cascades to the depth range which is actually on screen.
+*/
+
+layout(local_size_x = 16, local_size_y = 16) in;
+
+// The full resolution depth mip.
+layout(r32f, binding = 0) readonly uniform image2D zIn;
+
+// The depth bounds as float bits. Non-negative floats sort the same as their
+// bits, so they can be reduced with integer atomics.
+layout(std430, binding = 0) buffer DepthBoundsBlock
+{
+  uint minDepth;
+  uint maxDepth;
+};
+
+shared uint groupMin;
+shared uint groupMax;
+
+void main()
+{
+  if (gl_LocalInvocationIndex == 0)
+  {
+    groupMin = floatBitsToUint(1.0);
+    groupMax = 0u;
+  }
+  barrier();
+
+  ivec2 invoke = ivec2(gl_GlobalInvocationID.xy);
+  if (all(lessThan(invoke, imageSize(zIn).xy)))
+  {
+    // Skip the background.
+    float d = imageLoad(zIn, invoke).r;
+    if (d < 1.0)
+    {
+      atomicMin(groupMin, floatBitsToUint(d));
+      atomicMax(groupMax, floatBitsToUint(d));
+    }
+  }
+  barrier();
+
+  // One global atomic per group.
+  if (gl_LocalInvocationIndex == 0 && groupMin <= groupMax)
+  {
+    atomicMin(minDepth, groupMin);
+    atomicMax(maxDepth, groupMax);
+  }
+}
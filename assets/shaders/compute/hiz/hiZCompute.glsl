@@ -29,5 +29,23 @@ void main()
 
   // Find and store the local max depth.
   float maxD = max(max(d0, d1), max(d2, d3));
+
+  // Fold in the last row and column of odd sized mips so the reduction stays
+  // conservative.
+  ivec2 outSize = ivec2(imageSize(zOut).xy);
+  bool extraX = (mipSize.x & 1) != 0 && invoke.x == outSize.x - 1;
+  bool extraY = (mipSize.y & 1) != 0 && invoke.y == outSize.y - 1;
+  if (extraX)
+  {
+    maxD = max(maxD, imageLoad(zIn, previousCoords + ivec2(2, 0)).r);
+    maxD = max(maxD, imageLoad(zIn, previousCoords + ivec2(2, 1)).r);
+  }
+  if (extraY)
+  {
+    maxD = max(maxD, imageLoad(zIn, previousCoords + ivec2(0, 2)).r);
+    maxD = max(maxD, imageLoad(zIn, previousCoords + ivec2(1, 2)).r);
+  }
+  if (extraX && extraY)
+    maxD = max(maxD, imageLoad(zIn, previousCoords + ivec2(2, 2)).r);
   imageStore(zOut, invoke, vec4(maxD));
 }
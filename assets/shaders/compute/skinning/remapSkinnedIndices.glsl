@@ -0,0 +1,39 @@
+#type compute
+#version 460 core
+/*
+ * A compute shader to copy the indices of skinned mesh LODs out of the global
+ * index cache, rebased onto the skinned vertex buffer. Each workgroup row
+ * handles one job.
+ */
+
+#define GROUP_SIZE 64
+
+layout(local_size_x = GROUP_SIZE, local_size_y = 1) in;
+
+layout(std430, binding = 0) readonly buffer IndexBuffer
+{
+  uint v_indices[];
+};
+
+layout(std430, binding = 1) writeonly buffer SkinnedIndexBuffer
+{
+  uint v_skinnedIndices[];
+};
+
+// First source index (x), number of indices (y), first skinned index (z) and
+// the offset from the source vertices to the skinned vertices (w). The offset
+// may be negative, unsigned addition wraps around to the right index.
+layout(std430, binding = 2) readonly buffer JobBuffer
+{
+  uvec4 jobs[];
+};
+
+void main()
+{
+  const uvec4 job = jobs[gl_WorkGroupID.y];
+  const uint index = gl_GlobalInvocationID.x;
+  if (index >= job.y)
+    return;
+
+  v_skinnedIndices[job.z + index] = v_indices[job.x + index] + job.w;
+}
@@ -0,0 +1,73 @@
+#type compute
+#version 460 core
+/*
+ * A compute shader to skin the vertices of animated meshes. Each workgroup
+ * row handles one job, which poses a range of the global vertex cache with
+ * one animator's bone palette and writes it into the skinned vertex buffer.
+ * The skinned vertices are in model space and can be drawn like static
+ * geometry.
+ */
+
+#define GROUP_SIZE 64
+
+layout(local_size_x = GROUP_SIZE, local_size_y = 1) in;
+
+struct VertexData
+{
+  vec4 normal;
+  vec4 tangent;
+  vec4 position; // Uncompressed position (x, y, z). w is padding.
+  vec4 boneWeights; // Uncompressed bone weights.
+  ivec4 boneIDs; // Bone IDs.
+  vec4 texCoord; // UV coordinates (x, y). z and w are padding.
+};
+
+layout(std140, binding = 0) readonly buffer VertexBuffer
+{
+  VertexData v_vertices[];
+};
+
+layout(std140, binding = 1) writeonly buffer SkinnedVertexBuffer
+{
+  VertexData v_skinnedVertices[];
+};
+
+// The bone palettes of every animator this frame, back to back.
+layout(std140, binding = 2) readonly buffer BoneBlock
+{
+  mat4 u_boneMatrices[];
+};
+
+// First source vertex (x), number of vertices (y), first skinned vertex (z)
+// and the offset of the bone palette (w).
+layout(std430, binding = 3) readonly buffer JobBuffer
+{
+  uvec4 jobs[];
+};
+
+void main()
+{
+  const uvec4 job = jobs[gl_WorkGroupID.y];
+  const uint vertexIndex = gl_GlobalInvocationID.x;
+  if (vertexIndex >= job.y)
+    return;
+
+  VertexData vertex = v_vertices[job.x + vertexIndex];
+
+  // Vertices without any bones are left in bind pose.
+  mat4 skinMatrix = vertex.boneIDs.x > -1 ? u_boneMatrices[job.w + vertex.boneIDs.x] * vertex.boneWeights.x
+                                          : mat4(1.0);
+  if (vertex.boneIDs.y > -1)
+    skinMatrix += u_boneMatrices[job.w + vertex.boneIDs.y] * vertex.boneWeights.y;
+  if (vertex.boneIDs.z > -1)
+    skinMatrix += u_boneMatrices[job.w + vertex.boneIDs.z] * vertex.boneWeights.z;
+  if (vertex.boneIDs.w > -1)
+    skinMatrix += u_boneMatrices[job.w + vertex.boneIDs.w] * vertex.boneWeights.w;
+
+  const mat3 normalMatrix = mat3(skinMatrix);
+  vertex.position = vec4((skinMatrix * vec4(vertex.position.xyz, 1.0)).xyz, vertex.position.w);
+  vertex.normal = vec4(normalize(normalMatrix * vertex.normal.xyz), vertex.normal.w);
+  vertex.tangent = vec4(normalize(normalMatrix * vertex.tangent.xyz), vertex.tangent.w);
+
+  v_skinnedVertices[job.z + vertexIndex] = vertex;
+}
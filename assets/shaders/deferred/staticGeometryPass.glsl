@@ -4,17 +4,21 @@
  * A static mesh shader program for the geometry pass.
  */
 
+// Set in the instance flags of selected entities.
+#define SELECTED_FLAG 0x1u
+
 struct MaterialData
 {
   vec4 mRAE; // Metallic (r), roughness (g), AO (b) and emission (a);
   vec4 albedoReflectance; // Albedo (r, g, b) and reflectance (a);
+  vec4 textureLayers0; // Page layers of the albedo (x), normal (y), roughness (z) and metallic (w) maps. Negative if unpaged.
+  vec4 textureLayers1; // Page layers of the AO (x), specular F0 (y) and emission (z) maps. W is unused.
 };
 
 struct EntityData
 {
-  mat4 u_transform;
-  vec4 u_maskID; // Is this entity selected (x), and the entity ID (y). Z and w are unused.
-  MaterialData u_material;
+  vec4 u_transformRows[3]; // The first three rows of the affine model matrix.
+  uvec4 u_ids; // The entity ID + 1 (x), the material ID (y) and the instance flags (z). W is unused.
 };
 
 struct VertexData
@@ -60,14 +64,20 @@ layout(std140, binding = 2) readonly buffer EntityBlock
   EntityData u_entityData[];
 };
 
+// The compiled material parameters, indexed by material ID.
+layout(std140, binding = 4) readonly buffer MaterialBlock
+{
+  MaterialData u_materials[];
+};
+
 // Vertex properties for shading.
 out VERT_OUT
 {
   vec3 fNormal;
   vec2 fTexCoords;
   mat3 fTBN;
-  vec2 fMaskID;
-  MaterialData fMaterialData;
+  flat uvec2 fEntityID;
+  flat MaterialData fMaterialData;
 } vertOut;
 
 void main()
@@ -75,11 +85,14 @@ void main()
   const uint vIndex = v_indices[gl_VertexID];
   const VertexData vertex = v_vertices[vIndex];
 
-  // Compute the index of this draw into the global buffer.
-  const int instance = gl_InstanceID + u_drawData;
+  // Compute the index of this draw into the global buffer. Cluster draws
+  // store the entity index in the base instance.
+  const int instance = gl_BaseInstance + gl_InstanceID + u_drawData;
 
   // Fetch the transform from the global buffer.
-  const mat4 modelMatrix = u_entityData[instance].u_transform;
+  const EntityData entity = u_entityData[instance];
+  const mat4 modelMatrix = transpose(mat4(entity.u_transformRows[0], entity.u_transformRows[1],
+                                          entity.u_transformRows[2], vec4(0.0, 0.0, 0.0, 1.0)));
 
   // Tangent to world matrix calculation.
   vec3 normal = normalize(vec3(modelMatrix * vertex.normal));
@@ -91,8 +104,8 @@ void main()
   vertOut.fNormal = normal;
   vertOut.fTexCoords = vertex.texCoord.xy;
   vertOut.fTBN = mat3(tangent, bitangent, normal);
-  vertOut.fMaskID = u_entityData[instance].u_maskID.xy;
-  vertOut.fMaterialData = u_entityData[instance].u_material;
+  vertOut.fEntityID = uvec2(entity.u_ids.x, entity.u_ids.z & SELECTED_FLAG);
+  vertOut.fMaterialData = u_materials[entity.u_ids.y];
 }
 
 #type fragment
@@ -100,14 +113,15 @@ layout(location = 0) out vec4 gNormal; // z and w components unused.
 layout(location = 1) out vec4 gAlbedo;
 layout(location = 2) out vec4 gMatProp;
 layout(location = 3) out vec4 gEmission;
+layout(location = 4) out uvec2 gEntityID; // The entity ID + 1 (x) and the selection mask (y).
 
 in VERT_OUT
 {
 	vec3 fNormal;
   vec2 fTexCoords;
 	mat3 fTBN;
-  vec2 fMaskID;
-  MaterialData fMaterialData;
+  flat uvec2 fEntityID;
+  flat MaterialData fMaterialData;
 } fragIn;
 
 layout(binding = 0) uniform sampler2D albedoMap;
@@ -118,9 +132,22 @@ layout(binding = 4) uniform sampler2D aOcclusionMap;
 layout(binding = 5) uniform sampler2D specF0Map;
 layout(binding = 6) uniform sampler2D emissionMap;
 
-vec3 getNormal(sampler2D normalMap, mat3 tbn, vec2 texCoords)
+// Texture pages, used instead of the maps above if the material is paged.
+layout(binding = 7) uniform sampler2DArray albedoPage;
+layout(binding = 8) uniform sampler2DArray normalPage;
+layout(binding = 9) uniform sampler2DArray roughnessPage;
+layout(binding = 10) uniform sampler2DArray metallicPage;
+layout(binding = 11) uniform sampler2DArray aOcclusionPage;
+layout(binding = 12) uniform sampler2DArray specF0Page;
+layout(binding = 13) uniform sampler2DArray emissionPage;
+
+vec4 sampleMaterial(sampler2D map, sampler2DArray page, float layer, vec2 texCoords)
+{
+  return layer >= 0.0 ? texture(page, vec3(texCoords, layer)) : texture(map, texCoords);
+}
+
+vec3 getNormal(vec3 n, mat3 tbn)
 {
-  vec3 n = texture(normalMap, texCoords).xyz;
   n = normalize(2.0 * n - 1.0.xxx);
   n = tbn * n;
   return normalize(n);
@@ -143,22 +170,28 @@ vec2 encodeNormal(vec3 v)
 
 void main()
 {
-  vec4 albedo = texture(albedoMap, fragIn.fTexCoords);
+  const vec2 uv = fragIn.fTexCoords;
+  const vec4 layers0 = fragIn.fMaterialData.textureLayers0;
+  const vec4 layers1 = fragIn.fMaterialData.textureLayers1;
+
+  vec4 albedo = sampleMaterial(albedoMap, albedoPage, layers0.x, uv);
   vec4 albedoReflectance = fragIn.fMaterialData.albedoReflectance;
   vec4 mrae = fragIn.fMaterialData.mRAE;
   if (albedo.a < 1e-4)
     discard;
 
   gAlbedo = vec4(pow(albedo.rgb * albedoReflectance.rgb, vec3(u_nearFarGamma.z)), 1.0);
-  gAlbedo.a = dot(texture(specF0Map, fragIn.fTexCoords).rgb, (1.0 / 3.0).xxx) * albedoReflectance.a;
-  gNormal.rg = encodeNormal(getNormal(normalMap, fragIn.fTBN, fragIn.fTexCoords));
+  gAlbedo.a = dot(sampleMaterial(specF0Map, specF0Page, layers1.y, uv).rgb, (1.0 / 3.0).xxx) * albedoReflectance.a;
+  gNormal.rg = encodeNormal(getNormal(sampleMaterial(normalMap, normalPage, layers0.y, uv).xyz, fragIn.fTBN));
   gNormal.ba = 1.0.xx; // TODO: per-fragment tangents.
 
-  gMatProp.r = texture(metallicMap, fragIn.fTexCoords).r * mrae.r;
-  gMatProp.g = texture(roughnessMap, fragIn.fTexCoords).r * mrae.g;
-  gMatProp.b = 1.0 + mrae.b * (texture(aOcclusionMap, fragIn.fTexCoords).r - 1.0);
+  gMatProp.r = sampleMaterial(metallicMap, metallicPage, layers0.w, uv).r * mrae.r;
+  gMatProp.g = sampleMaterial(roughnessMap, roughnessPage, layers0.z, uv).r * mrae.g;
+  gMatProp.b = 1.0 + mrae.b * (sampleMaterial(aOcclusionMap, aOcclusionPage, layers1.x, uv).r - 1.0);
   gMatProp.a = 1.0; // Anisotropy.
 
-  vec3 emission = pow(texture(emissionMap, fragIn.fTexCoords).rgb, vec3(u_nearFarGamma.z));
+  vec3 emission = pow(sampleMaterial(emissionMap, emissionPage, layers1.z, uv).rgb, vec3(u_nearFarGamma.z));
   gEmission = vec4(emission * mrae.a, 1.0);
+
+  gEntityID = fragIn.fEntityID;
 }
@@ -35,13 +35,13 @@ layout(std140, binding = 1) uniform PostProcessBlock
 };
 
 layout(binding = 0) uniform sampler2D gDepth;
-layout(binding = 1) uniform sampler2D gEntityIDMask;
+layout(binding = 1) uniform usampler2D gEntityIDMask;
 layout(binding = 2) uniform sampler2D screenColour;
 layout(binding = 3) uniform sampler2D bloomColour;
 
 // Output colour variable.
 layout(location = 0) out vec4 fragColour;
-layout(location = 1) out float fragID;
+layout(location = 1) out uint fragID;
 
 // Bloom.
 vec3 upsampleBoxTent(sampler2D bloomTexture, vec2 uv, float radius);
@@ -56,7 +56,7 @@ vec3 applyGamma(vec3 colour, float gamma);
 // Grid.
 vec3 applyGrid(vec3 colour, sampler2D gDepth, vec2 uvs, mat4 invVP, mat4 vP);
 // The outline.
-vec3 applyOutline(vec3 colour, sampler2D idMask, vec2 uvs);
+vec3 applyOutline(vec3 colour, usampler2D idMask, vec2 uvs);
 
 // Dithering to deband colours.
 vec3 screenSpaceDither(vec2 uvs);
@@ -92,7 +92,7 @@ void main()
   colour = colour + screenSpaceDither(gl_FragCoord.xy);
 
   fragColour = vec4(colour, 1.0);
-  fragID = texture(gEntityIDMask, fTexCoords).g;
+  fragID = texelFetch(gEntityIDMask, ivec2(gl_FragCoord.xy), 0).r;
 }
 
 // Helper functions.
@@ -412,22 +412,29 @@ vec3 applyGrid(vec3 colour, sampler2D gDepth, vec2 uvs, mat4 invVP, mat4 vP)
   return mix(colour, gridColour.rgb, xzDepthTest * aabb * gridColour.a);
 }
 
+// Fetch the selection mask stored next to the entity IDs.
+float fetchSelectionMask(usampler2D idMask, ivec2 texel)
+{
+  texel = clamp(texel, ivec2(0), textureSize(idMask, 0).xy - ivec2(1));
+  return float(texelFetch(idMask, texel, 0).g);
+}
+
 // Apply the outline.
-vec3 applyOutline(vec3 colour, sampler2D idMask, vec2 uvs)
+vec3 applyOutline(vec3 colour, usampler2D idMask, vec2 uvs)
 {
-  vec2 texel = 1.0.xx / vec2(textureSize(idMask, 0).xy);
+  ivec2 texel = ivec2(uvs * vec2(textureSize(idMask, 0).xy));
 
   // Populate the Sobel edge detection kernel.
   float kernel[9];
-  kernel[0] = texture(idMask, uvs + vec2(-texel.x, -texel.y)).r;
-	kernel[1] = texture(idMask, uvs + vec2(0.0, -texel.y)).r;
-	kernel[2] = texture(idMask, uvs + vec2(texel.x, -texel.y)).r;
-	kernel[3] = texture(idMask, uvs + vec2(-texel.x, 0.0)).r;
-	kernel[4] = texture(idMask, uvs).r;
-	kernel[5] = texture(idMask, uvs + vec2(texel.x, 0.0)).r;
-	kernel[6] = texture(idMask, uvs + vec2(-texel.x, texel.y)).r;
-	kernel[7] = texture(idMask, uvs + vec2(0.0, texel.y)).r;
-	kernel[8] = texture(idMask, uvs + vec2(texel.x, texel.y)).r;
+  kernel[0] = fetchSelectionMask(idMask, texel + ivec2(-1, -1));
+  kernel[1] = fetchSelectionMask(idMask, texel + ivec2(0, -1));
+  kernel[2] = fetchSelectionMask(idMask, texel + ivec2(1, -1));
+  kernel[3] = fetchSelectionMask(idMask, texel + ivec2(-1, 0));
+  kernel[4] = fetchSelectionMask(idMask, texel);
+  kernel[5] = fetchSelectionMask(idMask, texel + ivec2(1, 0));
+  kernel[6] = fetchSelectionMask(idMask, texel + ivec2(-1, 1));
+  kernel[7] = fetchSelectionMask(idMask, texel + ivec2(0, 1));
+  kernel[8] = fetchSelectionMask(idMask, texel + ivec2(1, 1));
 
   // Find the edge of the entity mask.
   float sobelEdgeH = kernel[2] + (2.0 * kernel[5]) + kernel[8] - (kernel[0] + (2.0 * kernel[3]) + kernel[6]);
@@ -1,9 +1,21 @@
 #type common
 #version 460 core
 /*
- * A directional light shadow shader for static meshes.
+ * A directional light shadow shader for static meshes. Every cascade is drawn in
+ * a single pass, the geometry shader routes triangles to the cascade viewports.
  */
 
+#define NUM_CASCADES 4
+
+// Set on instances which are in the shadow pass' own instance buffer.
+#define LOCAL_INSTANCE 0x80000000u
+
+struct EntityData
+{
+  vec4 u_transformRows[3]; // The first three rows of the affine model matrix.
+  uvec4 u_ids; // The entity ID + 1 (x), the material ID (y) and the instance flags (z). W is unused.
+};
+
 struct VertexData
 {
   vec4 normal;
@@ -15,12 +27,6 @@ struct VertexData
 };
 
 #type vertex
-// The view-projection matrix for the light.
-layout(std140, binding = 0) uniform LightSpaceBlock
-{
-  mat4 u_lightViewProj;
-};
-
 layout(std140, binding = 0) readonly buffer VertexBuffer
 {
   VertexData v_vertices[];
@@ -31,27 +37,79 @@ layout(std430, binding = 1) readonly buffer IndexBuffer
   uint v_indices[];
 };
 
-// The model matrix.
-layout(std140, binding = 2) readonly buffer TransformBlock
+// The retained entity data of the geometry pass.
+layout(std140, binding = 2) readonly buffer RetainedEntityBlock
 {
-  mat4 u_transforms[];
+  EntityData u_retainedEntityData[];
 };
 
-// The draw to transform matrix mapping.
-layout(std430, binding = 4) readonly buffer DrawTransformMapping
+// Instances which aren't retained.
+layout(std140, binding = 3) readonly buffer LocalEntityBlock
 {
-  uint u_mapping[];
+  EntityData u_localEntityData[];
 };
 
+// The instance data index (x) and the cascades each instance survived
+// culling in (y), one bit per cascade.
+layout(std430, binding = 4) readonly buffer CasterInstanceBlock
+{
+  uvec2 u_casterInstances[];
+};
+
+out VERT_OUT
+{
+  flat uint fCascadeMask;
+} vertOut;
+
 void main()
 {
   const uint vIndex = v_indices[gl_VertexID];
   const VertexData vertex = v_vertices[vIndex];
 
-  // Compute the index of this draw into the global buffer.
-  const uint instance = uint(gl_InstanceID) + u_mapping[uint(gl_DrawID)];
+  // Compute the index of this draw into the global buffer. Draws point at
+  // their culled instances with the base instance.
+  const uint instance = uint(gl_BaseInstance + gl_InstanceID);
+
+  const uvec2 caster = u_casterInstances[instance];
+  const EntityData entity = (caster.x & LOCAL_INSTANCE) != 0u ? u_localEntityData[caster.x & ~LOCAL_INSTANCE]
+                                                              : u_retainedEntityData[caster.x];
+
+  // World space position, the geometry shader projects it into each cascade.
+  const vec4 position = vec4(vertex.position.xyz, 1.0);
+  vertOut.fCascadeMask = caster.y;
+  gl_Position = vec4(dot(entity.u_transformRows[0], position), dot(entity.u_transformRows[1], position),
+                     dot(entity.u_transformRows[2], position), 1.0);
+}
+
+#type geometry
+layout(triangles, invocations = NUM_CASCADES) in;
+layout(triangle_strip, max_vertices = 3) out;
+
+// The view-projection matrices of the cascades.
+layout(std140, binding = 0) uniform LightSpaceBlock
+{
+  mat4 u_lightViewProj[NUM_CASCADES];
+};
+
+in VERT_OUT
+{
+  flat uint fCascadeMask;
+} geomIn[];
+
+void main()
+{
+  // Each invocation draws into one cascade. Skip the cascades the instance
+  // was culled from.
+  if ((geomIn[0].fCascadeMask & (1u << uint(gl_InvocationID))) == 0u)
+    return;
 
-  gl_Position = u_lightViewProj * u_transforms[instance] * vec4(vertex.position.xyz, 1.0);
+  for (uint i = 0; i < 3; i++)
+  {
+    gl_Position = u_lightViewProj[gl_InvocationID] * gl_in[i].gl_Position;
+    gl_ViewportIndex = gl_InvocationID;
+    EmitVertex();
+  }
+  EndPrimitive();
 }
 
 #type fragment
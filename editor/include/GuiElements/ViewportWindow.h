@@ -6,6 +6,7 @@
 // Project includes.
 #include "Core/ApplicationBase.h"
 #include "GuiElements/GuiWindow.h"
+#include "Graphics/GPUReadback.h"
 #include "Scenes/Scene.h"
 #include "Scenes/Entity.h"
 
@@ -24,6 +25,10 @@ namespace Strontium
     void onImGuiRender(bool &isOpen, Shared<Scene> activeScene);
     void onUpdate(float dt, Shared<Scene> activeScene);
     void onEvent(Event &event);
+
+    // The distinct entities under the last finished pick, ordered by the
+    // number of pixels they cover. The editor selects the first one.
+    const std::vector<entt::entity>& getPickedEntities() const { return this->pickedEntities; }
   private:
     // Viewport windows.
     ImVec2 bounds[2];
@@ -31,13 +36,27 @@ namespace Strontium
     // Handle keyboard/mouse events.
     void onKeyPressEvent(KeyPressedEvent &keyEvent);
     void onMouseEvent(MouseClickEvent &mouseEvent);
+    void onMouseReleaseEvent(MouseReleasedEvent &mouseEvent);
 
     // Handle the drag and drop actions.
     void DNDTarget(Shared<Scene> activeScene);
     void loadDNDAsset(const std::string &filepath, Shared<Scene> activeScene);
 
-    // Screenpicking.
-    void selectEntity();
+    // Screenpicking. Picks are read back from the entity IDs asynchronously
+    // and resolved a few frames later. Dragging picks every entity in a
+    // region. Picks wait for a free pixel buffer if they're all in flight.
+    AsynchPixelReadback pickReadback;
+    std::vector<glm::ivec4> pendingPicks;
+    std::vector<uint> pickedIDs;
+    std::vector<std::pair<uint, entt::entity>> pickedCounts;
+    std::vector<entt::entity> pickedEntities;
+    bool selecting;
+    ImVec2 selectionStart;
+    glm::ivec2 toViewportPixel(const ImVec2 &screenPos);
+    void queueSelection(const ImVec2 &screenStart, const ImVec2 &screenEnd);
+    void flushPendingPicks();
+    void resolveSelection(Shared<Scene> activeScene);
+    void drawPickRegion();
 
     // Gizmo UI.
     int gizmoType;
@@ -48,8 +48,12 @@ namespace Strontium
                                           cSpec.internal, cSpec.format, cSpec.dataType);
     this->drawBuffer.attach(cSpec, colourAttachment);
     
-    cSpec.internal = TextureInternalFormats::R32f;
-    cSpec.format = TextureFormats::Red;
+    // The entity IDs, read back exactly when picking.
+    cSpec.internal = TextureInternalFormats::R32ui;
+    cSpec.format = TextureFormats::RedInt;
+    cSpec.dataType = TextureDataType::UInt;
+    cSpec.minFilter = TextureMinFilterParams::Nearest;
+    cSpec.maxFilter = TextureMaxFilterParams::Nearest;
     cSpec.sWrap = TextureWrapParams::ClampEdges;
     cSpec.tWrap = TextureWrapParams::ClampEdges;
     colourAttachment = FBOAttachment(FBOTargetParam::Colour1, FBOTextureParam::Texture2D,
@@ -523,8 +527,13 @@ namespace Strontium
       this->physicsTimer.msRecordTime(this->timerStorage[1]);
       this->renderTimer.msRecordTime(this->timerStorage[2]);
 
-      ImGui::Text("- Update frametime: %.3f ms\n- Physics frametime: %.3f ms\n- Render frametime: %.3f ms\n\t- Render submission frametime: %.3f ms\n", 
-                  timerStorage[0], timerStorage[1], timerStorage[2], this->currentScene->getRenderSubmitTime());
+      ImGui::Text("- Update frametime: %.3f ms\n\t- Animation frametime: %.3f ms (%u poses for %u animators, %u skipped, %u throttled)\n- Physics frametime: %.3f ms\n- Render frametime: %.3f ms\n\t- Render submission frametime: %.3f ms\n\t- Culling frametime: %.3f ms (%u / %u proxies visible)\n\t- Transform frametime: %.3f ms (%u / %u transforms updated)\n", 
+                  timerStorage[0], this->currentScene->getAnimationUpdateTime(), this->currentScene->getNumAnimationPoses(),
+                  this->currentScene->getNumAnimators(), this->currentScene->getNumAnimationsSkipped(),
+                  this->currentScene->getNumAnimationsThrottled(), timerStorage[1], timerStorage[2], this->currentScene->getRenderSubmitTime(),
+                  this->currentScene->getCullingTime(), this->currentScene->getNumVisibleProxies(),
+                  this->currentScene->getNumCullingProxies(), this->currentScene->getTransformUpdateTime(),
+                  this->currentScene->getNumTransformsUpdated(), this->currentScene->getNumTransforms());
       ImGui::PopTextWrapPos();
       ImGui::End();
     }
@@ -7,6 +7,7 @@
 
 #include "Serialization/YamlSerialization.h"
 #include "Utils/AsyncAssetLoading.h"
+#include "Utils/Benchmarks.h"
 
 #include "GuiElements/Styles.h"
 
@@ -117,13 +118,44 @@ namespace Strontium
             ImGui::Indent();
             ImGui::Text("Duration: %f", animation.getDuration());
             ImGui::Text("Ticks per second: %f", animation.getTPS());
-            ImGui::Text("Total number of nodes: %d", animation.getAniNodes().size());
+            ImGui::Text("Total number of nodes: %d", animation.getNumChannels());
+            ImGui::Text("Key memory: %.2f KiB compressed, %.2f KiB source", 
+                        static_cast<float>(animation.getCompressedSize()) / 1024.0f,
+                        static_cast<float>(animation.getSourceSize()) / 1024.0f);
+            ImGui::Text("Achieved error: %.6f translation, %.6f rad rotation, %.6f scale",
+                        animation.getCompiled().translationError, animation.getCompiled().rotationError,
+                        animation.getCompiled().scaleError);
+
+            auto compression = animation.getCompression();
+            bool recompress = false;
+            recompress = ImGui::DragFloat(("Max Translation Error##" + animation.getName()).c_str(), 
+                                          &compression.maxTranslationError, 0.0001f, 0.0f, 1.0f, "%.4f") || recompress;
+            recompress = ImGui::DragFloat(("Max Rotation Error (rad)##" + animation.getName()).c_str(), 
+                                          &compression.maxRotationError, 0.0001f, 0.0f, 0.1f, "%.4f") || recompress;
+            recompress = ImGui::DragFloat(("Max Scale Error##" + animation.getName()).c_str(), 
+                                          &compression.maxScaleError, 0.0001f, 0.0f, 1.0f, "%.4f") || recompress;
+            if (recompress)
+              animation.setCompression(compression);
+
+            if (ImGui::Button(("Run Sampling Benchmark##" + animation.getName()).c_str()))
+              Benchmarks::animationSampling(animation);
 
             ImGui::Separator();
             ImGui::Text("Animation Nodes");
             ImGui::Separator();
 
-            if (this->selectedAniNode)
+            // The source keys are released once the clip is compiled.
+            if (!animation.hasSourceKeys())
+            {
+              if (ImGui::Button(("Load Source Keys##" + animation.getName()).c_str()))
+                animation.loadSourceKeys();
+            }
+            else if (ImGui::Button(("Release Source Keys##" + animation.getName()).c_str()))
+            {
+              this->selectedAniNode = nullptr;
+              animation.releaseSourceKeys();
+            }
+            else if (this->selectedAniNode)
             {
               if (ImGui::BeginCombo("##aniNodes", this->selectedAniNode->name.c_str()))
               {
@@ -2,6 +2,7 @@
 
 // Project includes.
 #include "Graphics/Renderer.h"
+#include "Graphics/RenderPasses/SkinningPass.h"
 #include "Graphics/RenderPasses/GeometryPass.h"
 #include "Graphics/RenderPasses/ShadowPass.h"
 #include "Graphics/RenderPasses/HiZPass.h"
@@ -24,6 +25,8 @@
 #include "Graphics/RenderPasses/BloomPass.h"
 #include "Graphics/RenderPasses/PostProcessingPass.h"
 
+#include "Utils/Benchmarks.h"
+
 // ImGui includes.
 #include "imgui/imgui.h"
 #include "imgui/imgui_internal.h"
@@ -51,6 +54,19 @@ namespace Strontium
   RendererWindow::onImGuiRender(bool &isOpen, Shared<Scene> activeScene)
   {
     ImGui::Begin("Renderer Settings", &isOpen);
+    if (ImGui::CollapsingHeader("Skinning Pass"))
+    {
+      auto& renderPassManger = Renderer3D::getPassManager();
+      auto skinningPass = renderPassManger.getRenderPass<SkinningPass>();
+      auto skinningBlock = skinningPass->getInternalDataBlock<SkinningPassDataBlock>();
+
+      ImGui::Text("Frametime: %f ms", skinningBlock->frameTime);
+      ImGui::Text("Number of Skinned Poses: %u", skinningBlock->numPoses);
+      ImGui::Text("Number of Skinned Meshes: %u", skinningBlock->numSkinnedMeshes);
+      ImGui::Text("Number of Skinned LODs: %u", skinningBlock->numSkinnedLODs);
+      ImGui::Text("Number of Skinned Vertices: %u", skinningBlock->numSkinnedVertices);
+    }
+
     if (ImGui::CollapsingHeader("Shadow Pass"))
     {
       auto& renderPassManger = Renderer3D::getPassManager();
@@ -61,6 +77,31 @@ namespace Strontium
       ImGui::Text("Number of Draw Calls: %u", shadowBlock->numDrawCalls);
       ImGui::Text("Number of Instances: %u", shadowBlock->numInstances);
       ImGui::Text("Number of Triangles Drawn: %u", shadowBlock->numTrianglesDrawn);
+      ImGui::Text("Number of Casters Culled: %u", shadowBlock->numCastersCulled);
+      for (uint i = 0; i < NUM_CASCADES; i++)
+      {
+        ImGui::Text("Cascade %u: %u instances, %u triangles", i,
+                    shadowBlock->cascadeInstances[i], shadowBlock->cascadeTriangles[i]);
+      }
+      ImGui::Checkbox("Caster Culling", &shadowBlock->casterCulling);
+
+      ImGui::Checkbox("Sample Distribution Shadow Maps", &shadowBlock->useSDSM);
+      if (shadowBlock->useSDSM)
+      {
+        ImGui::Text("Visible Depth Range: %.3f to %.3f", shadowBlock->visibleDepthRange.x,
+                    shadowBlock->visibleDepthRange.y);
+        ImGui::DragFloat("Depth Range Padding", &shadowBlock->sdsmPadding, 0.01f, 0.0f, 1.0f);
+      }
+
+      ImGui::Text("Number of Cached Cascades: %u", shadowBlock->numCachedCascades);
+      ImGui::Text("Number of Staggered Cascades: %u", shadowBlock->numStaggeredCascades);
+      ImGui::Checkbox("Cache Static Shadows", &shadowBlock->cacheStaticShadows);
+      int firstStaggered = shadowBlock->firstStaggeredCascade;
+      if (ImGui::SliderInt("First Staggered Cascade", &firstStaggered, 0, NUM_CASCADES))
+        shadowBlock->firstStaggeredCascade = static_cast<uint>(firstStaggered);
+      int staggerInterval = shadowBlock->staggerInterval;
+      if (ImGui::DragInt("Stagger Interval", &staggerInterval, 1.0f, 1, 16))
+        shadowBlock->staggerInterval = static_cast<uint>(glm::max(staggerInterval, 1));
 
       ImGui::Separator();
 
@@ -157,9 +198,64 @@ namespace Strontium
       ImGui::Text("Frametime: %f ms", geometryBlock->frameTime);
       ImGui::Text("Number of Draw Calls: %u", geometryBlock->numDrawCalls);
       ImGui::Text("Number of Instances: %u", geometryBlock->numInstances);
+      ImGui::Text("Number of Retained Instances Uploaded: %u / %u", geometryBlock->numRetainedUploads,
+                  static_cast<uint>(geometryBlock->retainedEntityData.size()));
+      ImGui::Text("Number of Materials Uploaded: %u / %u", geometryBlock->numMaterialUploads,
+                  static_cast<uint>(geometryBlock->materialTable.size()));
       ImGui::Text("Number of Triangles Submitted: %u", geometryBlock->numTrianglesSubmitted);
       ImGui::Text("Number of Triangles Drawn: %u", geometryBlock->numTrianglesDrawn);
-      ImGui::Text("Number of Triangles Culled: %u", geometryBlock->numTrianglesSubmitted - geometryBlock->numTrianglesDrawn);
+      ImGui::Text("Number of Triangles Reduced by LODs: %u", geometryBlock->numTrianglesLODReduced);
+      ImGui::Text("Number of Triangles Culled: %u", geometryBlock->numTrianglesSubmitted - geometryBlock->numTrianglesDrawn
+                                                   - geometryBlock->numTrianglesLODReduced);
+
+      ImGui::Separator();
+
+      auto& globalBlock = Renderer3D::getStorage();
+      ImGui::DragFloat("LOD Bias", &globalBlock.lodBias, 0.05f, -4.0f, 4.0f);
+      if (ImGui::DragFloat("LOD Pixel Error", &globalBlock.lodPixelError, 0.05f))
+        globalBlock.lodPixelError = glm::max(globalBlock.lodPixelError, 0.0f);
+      ImGui::DragFloat("LOD Hysteresis", &globalBlock.lodHysteresis, 0.01f, 0.0f, 0.9f);
+      if (ImGui::Button("Run Frustum Culling Benchmark"))
+        Benchmarks::frustumCulling();
+
+      ImGui::Separator();
+
+      auto& occlusionStats = activeScene->getOcclusionStatistics();
+      ImGui::Text("Number of Occluders: %u (%u triangles)", occlusionStats.numOccluders, 
+                  occlusionStats.numOccluderTriangles);
+      ImGui::Text("Number of Submeshes Occluded: %u / %u", occlusionStats.numOccluded, occlusionStats.numTested);
+      ImGui::Text("Occlusion Rasterization Time: %.3f ms", occlusionStats.rasterTime);
+      ImGui::Checkbox("Occlusion Culling", &globalBlock.occlusionCulling);
+      ImGui::DragFloat("Occluder Screen Size", &globalBlock.occluderScreenSize, 0.01f, 0.0f, 1.0f);
+      int maxOccluders = globalBlock.maxOccluders;
+      if (ImGui::DragInt("Max Occluders", &maxOccluders, 1.0f, 0, 256))
+        globalBlock.maxOccluders = static_cast<uint>(glm::max(maxOccluders, 0));
+
+      ImGui::Separator();
+
+      ImGui::Checkbox("GPU Instance Culling", &geometryBlock->gpuInstanceCulling);
+      ImGui::Checkbox("Hi-Z Occlusion Culling", &geometryBlock->hiZOcclusionCulling);
+
+      ImGui::Separator();
+
+      ImGui::Text("Number of Texture Binds: %u (%u redundant binds skipped)", geometryBlock->numTextureBinds,
+                  geometryBlock->numTextureBindsSkipped);
+      ImGui::Text("Number of Material Binds Skipped: %u", geometryBlock->numMaterialBindsSkipped);
+      ImGui::Checkbox("Front to Back Sorting", &geometryBlock->depthSortDraws);
+      ImGui::Text("Number of Paged Materials: %u (%u textures in %u pages)", geometryBlock->numPagedMaterials,
+                  geometryBlock->texturePages.getNumResident(), geometryBlock->texturePages.getNumPages());
+      ImGui::Checkbox("Texture Paging", &geometryBlock->texturePaging);
+
+      ImGui::Separator();
+
+      ImGui::Text("Number of Clusters Submitted: %u", geometryBlock->numClustersSubmitted);
+      if (!geometryBlock->gpuClusterCulling)
+        ImGui::Text("Number of Clusters Culled: %u", geometryBlock->numClustersCulled);
+      ImGui::Checkbox("Cluster Culling", &geometryBlock->clusterCulling);
+      ImGui::Checkbox("GPU Cluster Culling", &geometryBlock->gpuClusterCulling);
+      int minMeshlets = geometryBlock->clusterCullingMinMeshlets;
+      if (ImGui::DragInt("Minimum Clusters", &minMeshlets, 1.0f, 1, 1024))
+        geometryBlock->clusterCullingMinMeshlets = static_cast<uint>(glm::max(minMeshlets, 1));
 
       ImGui::Separator();
       ImGui::Text("GBuffer:");
@@ -25,6 +25,9 @@ namespace Strontium
     , gizmoType(-1)
     , gizmoSelPos(-1.0f, -1.0f)
     , selectorSize(0.0f, 0.0f)
+    , pickReadback(4u)
+    , selecting(false)
+    , selectionStart(0.0f, 0.0f)
   { }
 
   void
@@ -48,6 +51,7 @@ namespace Strontium
                      this->parentLayer->getEditorSize(), ImVec2(0, 1), ImVec2(1, 0));
 
         this->manipulateEntity(this->parentLayer->getSelectedEntity());
+        this->drawPickRegion();
         this->drawGizmoSelector();
       }
       ImGui::EndChild();
@@ -59,7 +63,12 @@ namespace Strontium
   void
   ViewportWindow::onUpdate(float dt, Shared<Scene> activeScene)
   {
-
+    // Resolve the picks which have finished reading back, then queue the
+    // ones waiting on the pixel buffers they freed.
+    glm::ivec4 region;
+    while (this->pickReadback.fetch(this->pickedIDs, region))
+      this->resolveSelection(activeScene);
+    this->flushPendingPicks();
   }
 
   void
@@ -80,6 +89,12 @@ namespace Strontium
         this->onMouseEvent(mouseEvent);
         break;
       }
+      case EventType::MouseReleasedEvent:
+      {
+        auto mouseEvent = *(static_cast<MouseReleasedEvent*>(&event));
+        this->onMouseReleaseEvent(mouseEvent);
+        break;
+      }
       case EventType::WindowResizeEvent:
       {
         break;
@@ -147,30 +162,122 @@ namespace Strontium
     {
       case SR_MOUSE_BUTTON_1:
       {
-        if (appWindow->isKeyPressed(SR_KEY_LEFT_CONTROL))
-          this->selectEntity();
+        // Start a pick, it's queued when the button is released.
+        auto mousePos = ImGui::GetMousePos();
+        if (appWindow->isKeyPressed(SR_KEY_LEFT_CONTROL) && mousePos.x >= this->bounds[0].x 
+            && mousePos.y >= this->bounds[0].y && mousePos.x < this->bounds[1].x 
+            && mousePos.y < this->bounds[1].y)
+        {
+          this->selecting = true;
+          this->selectionStart = mousePos;
+        }
         break;
       }
     }
   }
 
-  // Screenpicking.
   void
-  ViewportWindow::selectEntity()
+  ViewportWindow::onMouseReleaseEvent(MouseReleasedEvent &mouseEvent)
   {
-    auto mousePos = ImGui::GetMousePos();
-    mousePos.x -= this->bounds[0].x;
-    mousePos.y -= this->bounds[0].y;
+    if (mouseEvent.getButton() != SR_MOUSE_BUTTON_1 || !this->selecting)
+      return;
+
+    this->selecting = false;
+    this->queueSelection(this->selectionStart, ImGui::GetMousePos());
+  }
+
+  // Convert a screen position into a pixel of the front buffer.
+  glm::ivec2
+  ViewportWindow::toViewportPixel(const ImVec2 &screenPos)
+  {
+    glm::vec2 pixel = glm::vec2(screenPos.x - this->bounds[0].x, screenPos.y - this->bounds[0].y);
+    pixel.y = (this->parentLayer->getEditorSize()).y - pixel.y;
+
+    return glm::ivec2(glm::floor(pixel));
+  }
+
+  // Screenpicking. Queue a read of the entity IDs under the dragged region,
+  // a click reads a single pixel.
+  void
+  ViewportWindow::queueSelection(const ImVec2 &screenStart, const ImVec2 &screenEnd)
+  {
+    const glm::ivec2 start = this->toViewportPixel(screenStart);
+    const glm::ivec2 end = this->toViewportPixel(screenEnd);
+    const glm::ivec2 minCorner = glm::min(start, end);
+    const glm::ivec2 extent = glm::abs(end - start) + glm::ivec2(1);
+
+    this->pendingPicks.emplace_back(minCorner, extent);
+    this->flushPendingPicks();
+  }
+
+  // Queue the waiting picks in order until the pixel buffers are full. Picks
+  // which miss the front buffer entirely have nothing to read and are dropped.
+  void
+  ViewportWindow::flushPendingPicks()
+  {
+    uint numFlushed = 0u;
+    for (auto& pick : this->pendingPicks)
+    {
+      if (this->pickReadback.isFull())
+        break;
+
+      this->pickReadback.queueRead(this->parentLayer->getFrontBuffer(), FBOTargetParam::Colour1,
+                                   glm::ivec2(pick.x, pick.y), glm::ivec2(pick.z, pick.w));
+      numFlushed++;
+    }
+
+    this->pendingPicks.erase(this->pendingPicks.begin(), this->pendingPicks.begin() + numFlushed);
+  }
 
-    mousePos.y = (this->parentLayer->getEditorSize()).y - mousePos.y;
-    if (mousePos.x >= 0.0f && mousePos.y >= 0.0f &&
-        mousePos.x < (this->parentLayer->getEditorSize()).x && mousePos.y < (this->parentLayer->getEditorSize()).y)
+  // Collect the distinct entities of a finished pick and select the one
+  // covering the most pixels. The IDs are offset by one so empty pixels are
+  // zero. Nothing under the pick clears the selection.
+  void
+  ViewportWindow::resolveSelection(Shared<Scene> activeScene)
+  {
+    auto& registry = activeScene->getRegistry();
+    std::sort(this->pickedIDs.begin(), this->pickedIDs.end());
+
+    this->pickedCounts.clear();
+    for (uint i = 0; i < this->pickedIDs.size();)
     {
-      int id = this->parentLayer->getFrontBuffer().readPixel(FBOTargetParam::Colour1, glm::vec2(mousePos.x, mousePos.y)) - 1;
-      
-      EventDispatcher* dispatcher = EventDispatcher::getInstance();
-      dispatcher->queueEvent(new EntitySwapEvent(id, this->parentLayer->getActiveScene().get()));
+      uint j = i + 1u;
+      while (j < this->pickedIDs.size() && this->pickedIDs[j] == this->pickedIDs[i])
+        j++;
+
+      // The entity might have been deleted while the pick was in flight.
+      const entt::entity entity = static_cast<entt::entity>(this->pickedIDs[i] - 1u);
+      if (this->pickedIDs[i] > 0u && registry.valid(entity))
+        this->pickedCounts.emplace_back(j - i, entity);
+      i = j;
     }
+
+    std::stable_sort(this->pickedCounts.begin(), this->pickedCounts.end(),
+                     [](const std::pair<uint, entt::entity> &a, const std::pair<uint, entt::entity> &b)
+                     { return a.first > b.first; });
+
+    this->pickedEntities.clear();
+    for (auto& [count, entity] : this->pickedCounts)
+      this->pickedEntities.push_back(entity);
+
+    EventDispatcher* dispatcher = EventDispatcher::getInstance();
+    if (this->pickedEntities.empty())
+      dispatcher->queueEvent(new EntitySwapEvent(-1, activeScene.get()));
+    else
+      dispatcher->queueEvent(new EntitySwapEvent(Entity(this->pickedEntities.front(), activeScene.get()),
+                                                 activeScene.get()));
+  }
+
+  void
+  ViewportWindow::drawPickRegion()
+  {
+    if (!this->selecting)
+      return;
+
+    auto drawList = ImGui::GetWindowDrawList();
+    auto mousePos = ImGui::GetMousePos();
+    drawList->AddRectFilled(this->selectionStart, mousePos, IM_COL32(255, 255, 255, 32));
+    drawList->AddRect(this->selectionStart, mousePos, IM_COL32(255, 255, 255, 128));
   }
 
   // Gizmo UI.
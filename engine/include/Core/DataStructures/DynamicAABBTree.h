@@ -0,0 +1,136 @@
+#pragma once
+
+// Macro include file.
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+#include "Core/Math.h"
+
+#define NULL_TREE_NODE -1
+
+namespace Strontium
+{
+  // A dynamic bounding volume hierarchy over world space AABBs. Leaves store
+  // fattened boxes so small movements don't need a reinsertion. Balanced with
+  // AVL style rotations on insertion and removal.
+  class DynamicAABBTree
+  {
+  public:
+    DynamicAABBTree(float margin = 0.1f);
+    ~DynamicAABBTree() = default;
+
+    // Create a proxy for a box. The returned ID stays valid until it is destroyed.
+    int createProxy(const glm::vec3 &min, const glm::vec3 &max, ulong userData);
+    void destroyProxy(int proxyID);
+
+    // Update the box of a proxy. Only reinserts the leaf if the new box leaves
+    // the fattened box. Returns true if the proxy was reinserted.
+    bool moveProxy(int proxyID, const glm::vec3 &min, const glm::vec3 &max);
+
+    // Remove all proxies.
+    void clear();
+
+    ulong getUserData(int proxyID) const { return this->nodes[proxyID].userData; }
+    uint numProxies() const { return this->proxyCount; }
+    int getHeight() const { return this->root == NULL_TREE_NODE ? 0 : this->nodes[this->root].height; }
+
+    // Traverse the tree and call callback(userData) for each proxy touching
+    // the frustum. Planes a node is fully inside of aren't tested again for
+    // its children, and nodes fully inside the frustum are enumerated
+    // without any tests.
+    template <typename Func>
+    void queryFrustum(const Frustum &frustum, Func callback) const
+    {
+      if (this->root == NULL_TREE_NODE)
+        return;
+
+      // Node and the mask of planes still to be tested.
+      std::vector<std::pair<int, uint>> &stack = this->traversalStack;
+      stack.clear();
+      stack.emplace_back(this->root, 0x3Fu);
+      while (!stack.empty())
+      {
+        auto [nodeID, planeMask] = stack.back();
+        stack.pop_back();
+
+        const TreeNode &node = this->nodes[nodeID];
+        const glm::vec3 center = 0.5f * (node.max + node.min);
+        const glm::vec3 extents = 0.5f * (node.max - node.min);
+
+        bool outside = false;
+        for (uint i = 0; i < 6 && planeMask != 0u; i++)
+        {
+          if (!(planeMask & (1u << i)))
+            continue;
+
+          const Plane &plane = frustum.sides[i];
+          const float r = glm::dot(extents, glm::abs(plane.normal));
+          const float s = signedPlaneDistance(plane, center);
+          if (s + r < 0.0f)
+          {
+            outside = true;
+            break;
+          }
+
+          // Fully on the inside of this plane.
+          if (s - r >= 0.0f)
+            planeMask &= ~(1u << i);
+        }
+
+        if (outside)
+          continue;
+
+        if (node.isLeaf())
+          callback(node.userData);
+        else
+        {
+          stack.emplace_back(node.child1, planeMask);
+          stack.emplace_back(node.child2, planeMask);
+        }
+      }
+    }
+  private:
+    struct TreeNode
+    {
+      glm::vec3 min;
+      glm::vec3 max;
+      ulong userData;
+
+      // Parent for nodes in the tree, next free node for nodes in the free list.
+      int parentOrNext;
+      int child1;
+      int child2;
+
+      // Leaves are at height 0, free nodes are at height -1.
+      int height;
+
+      TreeNode()
+        : min(0.0f)
+        , max(0.0f)
+        , userData(0u)
+        , parentOrNext(NULL_TREE_NODE)
+        , child1(NULL_TREE_NODE)
+        , child2(NULL_TREE_NODE)
+        , height(-1)
+      { }
+
+      bool isLeaf() const { return this->child1 == NULL_TREE_NODE; }
+    };
+
+    int allocateNode();
+    void freeNode(int nodeID);
+
+    void insertLeaf(int leafID);
+    void removeLeaf(int leafID);
+    int balance(int nodeID);
+
+    std::vector<TreeNode> nodes;
+    int root;
+    int freeList;
+    uint proxyCount;
+    float margin;
+
+    mutable std::vector<std::pair<int, uint>> traversalStack;
+  };
+}
@@ -5,6 +5,7 @@
 
 // STL includes.
 #include <queue>
+#include <vector>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -12,6 +13,7 @@
 #include <functional>
 #include <future>
 #include <atomic>
+#include <chrono>
 
 //------------------------------------------------------------
 // Internal jobsystem API.
@@ -72,16 +74,21 @@ namespace Strontium::JobSystem
     {
       while (true)
       {
-        std::unique_lock<std::mutex> taskLock(JobSystemInternal::poolData.taskMutex);
-        JobSystemInternal::poolData.signal.wait(taskLock, []()
+        std::shared_ptr<JobSystemInternal::Job> job;
         {
-          return !JobSystemInternal::poolData.tasks.empty() || !JobSystemInternal::poolData.isActive.load(std::memory_order_relaxed);
-        });
-    
-        if (!JobSystemInternal::poolData.isActive.load(std::memory_order_relaxed))
-          return;
-    
-        auto job = JobSystemInternal::poolData.tasks.pop();
+          std::unique_lock<std::mutex> taskLock(JobSystemInternal::poolData.taskMutex);
+          JobSystemInternal::poolData.signal.wait(taskLock, []()
+          {
+            return !JobSystemInternal::poolData.tasks.empty() || !JobSystemInternal::poolData.isActive.load(std::memory_order_relaxed);
+          });
+
+          if (!JobSystemInternal::poolData.isActive.load(std::memory_order_relaxed))
+            return;
+
+          job = JobSystemInternal::poolData.tasks.pop();
+        }
+
+        // Execute outside of the lock so the workers can run jobs concurrently.
         job->execute();
       }
     };
@@ -133,9 +140,86 @@ namespace Strontium::JobSystem
 
     std::future<retType> returnValue = newTask.get_future();
 
-    JobSystemInternal::poolData.tasks.emplace(createShared<JobSystemInternal::ReturnJob<retType>>(std::move(newTask)));
+    {
+      std::unique_lock<std::mutex> taskLock(JobSystemInternal::poolData.taskMutex);
+      JobSystemInternal::poolData.tasks.emplace(createShared<JobSystemInternal::ReturnJob<retType>>(std::move(newTask)));
+    }
     JobSystemInternal::poolData.signal.notify_one();
 
     return returnValue;
   }
+
+  // Pop and execute a single queued job on the calling thread. Returns false 
+  // if there was nothing to execute.
+  inline bool
+  executeNext()
+  {
+    std::shared_ptr<JobSystemInternal::Job> job;
+    {
+      std::unique_lock<std::mutex> taskLock(JobSystemInternal::poolData.taskMutex);
+      if (JobSystemInternal::poolData.tasks.empty())
+        return false;
+
+      job = JobSystemInternal::poolData.tasks.pop();
+    }
+
+    job->execute();
+    return true;
+  }
+
+  // Wait on a future, executing queued jobs while waiting. Safe to call from 
+  // within a job since the waiting thread never blocks the queue.
+  template <typename ReturnType>
+  ReturnType wait(std::future<ReturnType> &future)
+  {
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      if (!executeNext())
+        std::this_thread::yield();
+    }
+
+    return future.get();
+  }
+
+  // Number of batches parallelFor() splits count items into. Batches hold at
+  // least minBatchSize items, and there are never more batches than threads.
+  inline unsigned int
+  parallelForBatches(unsigned int count, unsigned int minBatchSize)
+  {
+    if (count == 0u)
+      return 0u;
+
+    const unsigned int maxBatches = static_cast<unsigned int>(getMaxConcurrency()) + 1u;
+    const unsigned int batchMin = minBatchSize > 0u ? minBatchSize : 1u;
+    const unsigned int batches = (count + batchMin - 1u) / batchMin;
+    return batches < maxBatches ? batches : maxBatches;
+  }
+
+  // Split [0, count) into contiguous batches and call func(start, end, batch)
+  // for each on the workers. The calling thread runs the first batch and 
+  // helps with the rest, returns once every batch is done. Batches are in 
+  // order, so per-batch output can be merged deterministically.
+  template <typename Function>
+  void parallelFor(unsigned int count, unsigned int minBatchSize, Function&& func)
+  {
+    const unsigned int numBatches = parallelForBatches(count, minBatchSize);
+    if (numBatches == 0u)
+      return;
+
+    const unsigned int batchSize = (count + numBatches - 1u) / numBatches;
+
+    std::vector<std::future<void>> batches;
+    batches.reserve(numBatches - 1u);
+    for (unsigned int batch = 1u; batch < numBatches; batch++)
+    {
+      const unsigned int start = batch * batchSize < count ? batch * batchSize : count;
+      const unsigned int end = start + batchSize < count ? start + batchSize : count;
+      batches.emplace_back(push([&func, start, end, batch]() { func(start, end, batch); }));
+    }
+
+    func(0u, batchSize < count ? batchSize : count, 0u);
+
+    for (auto& future : batches)
+      wait(future);
+  }
 }
@@ -7,6 +7,14 @@
 #include "Core/ApplicationBase.h"
 #include "Graphics/ShadingPrimatives.h"
 
+// SIMD instruction sets available to the build.
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+  #define STRONTIUM_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define STRONTIUM_SSE
+#endif
+
 namespace Strontium
 {
   struct Plane
@@ -79,6 +87,25 @@ namespace Strontium
     { }
   };
 
+  // Structure of arrays AABBs for batched culling.
+  struct AABBBatch
+  {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> extentX;
+    std::vector<float> extentY;
+    std::vector<float> extentZ;
+
+    void push(const BoundingBox &box);
+    void push(const glm::vec3 &min, const glm::vec3 &max);
+    void push(const glm::vec3 &min, const glm::vec3 &max, const glm::mat4 &transform);
+
+    void reserve(uint numBoxes);
+    void clear();
+    uint size() const { return this->centerX.size(); }
+  };
+
   struct Frustum
   {
     glm::vec3 corners[8];
@@ -107,4 +134,29 @@ namespace Strontium
   bool boundingBoxInFrustum(const Frustum &frustum, const glm::vec3 min, const glm::vec3 max);
   bool boundingBoxInFrustum(const Frustum& frustum, const glm::vec3 min, const glm::vec3 max, 
                             const glm::mat4 &transform);
+
+  // Batched AABB-frustum tests. Box i is visible if bit (i % 32) of 
+  // outVisibility[i / 32] is set. Returns the number of visible boxes.
+  // Uses the widest kernel available to the build.
+  uint batchBoundingBoxInFrustum(const Frustum &frustum, const AABBBatch &boxes,
+                                 std::vector<uint> &outVisibility);
+  inline bool batchVisible(const std::vector<uint> &visibility, uint index)
+  {
+    return (visibility[index / 32u] >> (index % 32u)) & 1u;
+  }
+
+  // The individual kernels. Kernels which aren't supported by the build fall 
+  // back to the next narrowest kernel.
+  uint batchBoundingBoxInFrustumScalar(const Frustum &frustum, const AABBBatch &boxes,
+                                       std::vector<uint> &outVisibility);
+  uint batchBoundingBoxInFrustumSSE(const Frustum &frustum, const AABBBatch &boxes,
+                                    std::vector<uint> &outVisibility);
+  uint batchBoundingBoxInFrustumAVX2(const Frustum &frustum, const AABBBatch &boxes,
+                                     std::vector<uint> &outVisibility);
+  bool batchCullingSSESupported();
+  bool batchCullingAVX2Supported();
+
+  // Column major matrix product, out = a * b. Out may alias either operand.
+  // Uses SSE when the build supports it.
+  void multiplyMatrices(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &out);
 }
@@ -14,6 +14,7 @@ namespace Strontium
 {
   // Forward declare various classes.
   class Model;
+  class Animation;
 
   struct VertexBone
   {
@@ -60,24 +61,199 @@ namespace Strontium
     SceneNode() = default;
   };
 
+  // A range of keys in the flat key arrays of a clip.
+  struct AnimationTrack
+  {
+    uint firstKey;
+    uint numKeys;
+
+    AnimationTrack(uint firstKey = 0u, uint numKeys = 0u)
+      : firstKey(firstKey)
+      , numKeys(numKeys)
+    { }
+  };
+
+  // The bounds a clip is compressed within. Translations and scales are in
+  // model units, rotations in radians.
+  struct AnimationCompression
+  {
+    float maxTranslationError;
+    float maxRotationError;
+    float maxScaleError;
+
+    AnimationCompression(float maxTranslationError = 1e-3f, float maxRotationError = 1e-3f,
+                         float maxScaleError = 1e-3f)
+      : maxTranslationError(maxTranslationError)
+      , maxRotationError(maxRotationError)
+      , maxScaleError(maxScaleError)
+    { }
+  };
+
+  // A quantized key. Translations and scales store each component relative
+  // to the range of their track. Rotations store the three smallest
+  // components of the quaternion in the low 15 bits, and the index of the
+  // dropped one in the top bits of x and y.
+  struct PackedAnimationKey
+  {
+    ushort x;
+    ushort y;
+    ushort z;
+  };
+
+  // Dequantizes the keys of a translation or scale track. Tracks whose range
+  // is too large for 16 bits to meet the error bound store the low 16 bits
+  // of a 32 bit key in a second array, starting at lowKeys. Tracks without
+  // low keys have lowKeys of -1.
+  struct AnimationKeyRange
+  {
+    glm::vec3 min;
+    glm::vec3 step;
+    glm::vec3 lowStep;
+    int lowKeys;
+
+    AnimationKeyRange(const glm::vec3 &min = glm::vec3(0.0f), const glm::vec3 &step = glm::vec3(0.0f),
+                      const glm::vec3 &lowStep = glm::vec3(0.0f), int lowKeys = -1)
+      : min(min)
+      , step(step)
+      , lowStep(lowStep)
+      , lowKeys(lowKeys)
+    { }
+  };
+
+  // An animation clip compiled against its model. The node hierarchy is
+  // flattened so parents come before their children, and the keys of every
+  // channel are stored in flat arrays of times and values. Nodes without a
+  // channel have a track index of -1, nodes which aren't bones a bone index
+  // of -1.
+  //
+  // Keys are compressed. Keys which can be interpolated from their neighbours
+  // within the error bounds are dropped, times are quantized to 16 bits over
+  // the clip and the values are packed into 16 bits per component, or 32
+  // bits for tracks which need them. The largest error of the compressed
+  // keys against the source keys is recorded, it can exceed the bounds if
+  // they're below the precision of the packed keys.
+  struct CompiledAnimation
+  {
+    std::vector<std::string> nodeNames;
+    std::vector<int> parents;
+    std::vector<glm::mat4> bindTransforms;
+    std::vector<int> boneIndices;
+    std::vector<glm::mat4> boneOffsets;
+    std::vector<int> tracks;
+
+    std::vector<AnimationTrack> translationTracks;
+    std::vector<AnimationTrack> rotationTracks;
+    std::vector<AnimationTrack> scaleTracks;
+
+    std::vector<AnimationKeyRange> translationRanges;
+    std::vector<AnimationKeyRange> scaleRanges;
+
+    // Ticks per quantized time step.
+    float timeStep;
+
+    std::vector<ushort> translationTimes;
+    std::vector<PackedAnimationKey> translationKeys;
+    std::vector<ushort> rotationTimes;
+    std::vector<PackedAnimationKey> rotationKeys;
+    std::vector<ushort> scaleTimes;
+    std::vector<PackedAnimationKey> scaleKeys;
+
+    std::vector<PackedAnimationKey> translationLowKeys;
+    std::vector<PackedAnimationKey> scaleLowKeys;
+
+    float translationError;
+    float rotationError;
+    float scaleError;
+
+    CompiledAnimation()
+      : timeStep(1.0f)
+      , translationError(0.0f)
+      , rotationError(0.0f)
+      , scaleError(0.0f)
+    { }
+  };
+
+  // The keys an animator last sampled on each track. Playback mostly moves
+  // forward by a fraction of a key, so searching from the last key is
+  // amortized constant time. Also holds the scratch space for the node
+  // transforms.
+  struct AnimationCursor
+  {
+    const Animation* animation;
+
+    std::vector<uint> translationKeys;
+    std::vector<uint> rotationKeys;
+    std::vector<uint> scaleKeys;
+
+    std::vector<glm::mat4> nodeTransforms;
+
+    AnimationCursor()
+      : animation(nullptr)
+    { }
+
+    void reset() { this->animation = nullptr; }
+  };
+
   class Animation
   {
   public:
-    Animation(const aiAnimation* animation, Model* parentModel);
+    // The source file and the index of the clip in it are used to reload
+    // the source keys, which are released once the clip is compiled.
+    Animation(const aiAnimation* animation, Model* parentModel, const std::string &sourcePath = "",
+              uint sourceIndex = 0u);
     Animation(Model* parentModel);
     ~Animation();
 
     void loadAnimation(const aiAnimation* animation);
 
+    // The source keys are only needed by the key inspector, the reference
+    // evaluation and recompression. Load them from the source file on
+    // demand and release them when done.
+    bool loadSourceKeys();
+    void releaseSourceKeys();
+    bool hasSourceKeys() const { return !this->animationNodes.empty(); }
+
+    // Sample the compiled clip. The cursor is optional, without one every
+    // key search starts from the first key.
     void computeBoneTransforms(float aniTime, std::vector<glm::mat4> &outBonesSkinned, 
-                               robin_hood::unordered_flat_map<std::string, glm::mat4>& outBonesUnskinned);
+                               robin_hood::unordered_flat_map<std::string, glm::mat4>& outBonesUnskinned,
+                               AnimationCursor* cursor = nullptr);
+
+    // Sample the skinned pose of the compiled clip straight into a palette
+    // with room for getNumBones() matrices. Only valid for skinned models.
+    void computeSkinnedPose(float aniTime, glm::mat4* outBones, AnimationCursor* cursor = nullptr);
+
+    // The original evaluation of the string keyed nodes. Kept as a reference
+    // to validate and benchmark the compiled clip against. Requires the
+    // source keys to be loaded.
+    void computeBoneTransformsReference(float aniTime, std::vector<glm::mat4> &outBonesSkinned, 
+                                        robin_hood::unordered_flat_map<std::string, glm::mat4>& outBonesUnskinned);
 
     float getDuration() const { return this->duration; }
     float getTPS() const { return this->ticksPerSecond; }
     uint getNumBones() const;
+    bool isSkinned() const;
     std::string getName() const { return this->name; }
+    uint getNumChannels() const { return this->numChannels; }
     robin_hood::unordered_flat_map<std::string, AnimationNode>& getAniNodes() { return this->animationNodes; }
+    const CompiledAnimation& getCompiled() const { return this->compiled; }
+
+    // Recompress the clip with new error bounds.
+    void setCompression(const AnimationCompression &compression);
+    const AnimationCompression& getCompression() const { return this->compression; }
+
+    // The memory used by the keys of the source and the compressed clip, in
+    // bytes.
+    uint getSourceSize() const { return this->sourceSize; }
+    uint getCompressedSize() const;
   private:
+    void readKeys(const aiAnimation* animation);
+    void compile();
+
+    // Accumulate the global transforms of the compiled nodes into the
+    // cursor's scratch space.
+    void evaluateNodes(float aniTime, AnimationCursor &cursor);
+
     glm::mat4 interpolateTranslation(float aniTime, const AnimationNode &node);
     glm::mat4 interpolateRotation(float aniTime, const AnimationNode &node);
     glm::mat4 interpolateScale(float aniTime, const AnimationNode &node);
@@ -92,6 +268,13 @@ namespace Strontium
     Model* parentModel;
 
     robin_hood::unordered_flat_map<std::string, AnimationNode> animationNodes;
+    CompiledAnimation compiled;
+    AnimationCompression compression;
+
+    std::string sourcePath;
+    uint sourceIndex;
+    uint numChannels;
+    uint sourceSize;
 
     std::string name;
     float duration;
@@ -106,17 +289,51 @@ namespace Strontium
 
     void setAnimation(Animation* animation, const Asset::Handle &modelHandle);
 
+    // Advance the animation time. Returns true if the pose has to be
+    // evaluated this frame.
+    bool advance(float dt);
+
+    // Evaluate the pose at the current time into the animator's own storage.
+    void evaluate();
+
+    // Advance and evaluate, for animators which are updated on their own.
     void onUpdate(float dt);
 
+    // Use a skinned pose evaluated into a palette shared with other
+    // animators. The palette has to stay alive until the next update.
+    void setSharedPose(const glm::mat4* palette) { this->sharedPalette = palette; }
+
+    // Copy a shared pose into the animator's own storage, so it survives the
+    // shared palette being reused.
+    void detachPose();
+
+    // Visibility from the last frame the animator was drawn, used to throttle
+    // its updates. The screen height is in pixels.
+    void setVisibility(bool visible, float screenHeight) { this->visible = visible; this->screenHeight = screenHeight; }
+    bool isVisible() const { return this->visible; }
+    float getScreenHeight() const { return this->screenHeight; }
+
+    // Throttled animators evaluate a pose a few frames ahead and blend
+    // towards it from the pose they showed last. Start a blend which reaches
+    // the pose aheadTicks from now after numFrames steps.
+    void beginBlend(float aheadTicks, uint numFrames);
+    void stepBlend();
+    void resetBlend() { this->blendFrames = 0u; this->blendFrame = 0u; }
+    bool isBlending() const { return this->blendFrames > 0u; }
+    uint getBlendFramesLeft() const { return this->blendFrames - this->blendFrame; }
+
     void startAnimation() { this->animating = true; this->paused = false; }
     void pauseAnimation() { this->paused = true; }
     void resumeAnimation() { this->paused = false; }
     void stopAnimation() { this->animating = false; this->currentAniTime = 0.0f; this->paused = true; }
     void setScrubbing() { this->scrubbing = true;  }
 
-    std::vector<glm::mat4>& getFinalBoneTransforms() { return this->finalBoneTransforms; }
+    // The skinned bone palette, either shared or owned by the animator.
+    const glm::mat4* getBonePalette() const;
+    uint getNumBones() const;
     robin_hood::unordered_flat_map<std::string, glm::mat4>& getFinalUnSkinnedTransforms() { return this->unSkinnedFinalTransforms; }
     Animation* getStoredAnimation() { return this->storedAnimation; }
+    AnimationCursor& getCursor() { return this->cursor; }
     float& getAnimationTime() { return this->currentAniTime; }
     bool isAnimating() { return this->animating; }
     bool isPaused() { return this->paused; }
@@ -126,9 +343,19 @@ namespace Strontium
     float currentAniTime;
     Asset::Handle storedModel;
     Animation* storedAnimation;
+    AnimationCursor cursor;
     std::vector<glm::mat4> finalBoneTransforms;
+    const glm::mat4* sharedPalette;
     robin_hood::unordered_flat_map<std::string, glm::mat4> unSkinnedFinalTransforms;
 
+    bool visible;
+    float screenHeight;
+
+    std::vector<glm::mat4> blendStart;
+    std::vector<glm::mat4> blendTarget;
+    uint blendFrames;
+    uint blendFrame;
+
     bool animating;
     bool paused;
     bool scrubbing;
@@ -0,0 +1,73 @@
+#pragma once
+
+// Macro include file.
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+
+#define MAX_TRACKED_TEXTURE_UNITS 16
+
+namespace Strontium
+{
+  class Texture2D;
+  class Texture2DArray;
+
+  // Draw passes, the most significant bits of a sort key.
+  enum class DrawSortPass
+  {
+    Static = 0u,
+    Clustered = 1u,
+    Dynamic = 2u
+  };
+
+  // A draw and its packed sort key. From most to least significant the key
+  // holds the pass (4 bits), shader (12 bits), material (24 bits) and a
+  // front to back depth bucket (24 bits).
+  struct SortedDraw
+  {
+    ulong key;
+    uint index;
+
+    SortedDraw(ulong key = 0u, uint index = 0u)
+      : key(key)
+      , index(index)
+    { }
+  };
+
+  // Tracks the 2D textures bound to the first few texture units so
+  // redundant binds can be skipped. Has to be reset whenever something
+  // outside of the cache may have bound textures.
+  class TextureBindCache
+  {
+  public:
+    TextureBindCache();
+    ~TextureBindCache() = default;
+
+    void reset();
+
+    // Bind a texture to a unit if it isn't already bound. Units are assumed
+    // to only ever hold one texture type.
+    void bind(Texture2D* texture, uint unit);
+    void bind(Texture2DArray* texture, uint unit);
+
+    uint getNumBinds() const { return this->numBinds; }
+    uint getNumSkipped() const { return this->numSkipped; }
+    void resetStatistics() { this->numBinds = 0u; this->numSkipped = 0u; }
+  private:
+    uint boundTextures[MAX_TRACKED_TEXTURE_UNITS];
+
+    uint numBinds;
+    uint numSkipped;
+  };
+}
+
+namespace Strontium::DrawSorting
+{
+  // Pack a sort key. Depth is the view distance, quantized over [0, maxDepth].
+  ulong packKey(DrawSortPass pass, uint shaderID, uint materialID, float depth, float maxDepth);
+
+  // Stable LSD radix sort on the keys, 8 bits per pass. Passes where every
+  // key has the same byte are skipped. Scratch is used as the second buffer.
+  void radixSort(std::vector<SortedDraw> &draws, std::vector<SortedDraw> &scratch);
+}
@@ -104,6 +104,9 @@ namespace Strontium
 
     // Misc functions.
     void blitzToOther(FrameBuffer &target, const FBOTargetParam &type);
+    // Copy the same region of this framebuffer into the target.
+    void blitzRegionToOther(FrameBuffer &target, const FBOTargetParam &type,
+                            uint xMin, uint yMin, uint oWidth, uint oHeight);
     int readPixel(const FBOTargetParam &target, const glm::vec2 &mousePos);
 
     // Update FBO properties.
@@ -112,6 +115,7 @@ namespace Strontium
 
     // Update the framebuffer state.
     void clear();
+    void clear(uint xMin, uint yMin, uint oWidth, uint oHeight);
     void setViewport(uint xMin = 0u, uint yMin = 0u);
     void setViewport(uint oWidth, uint oHeight, uint xMin, uint yMin);
     void setDrawBuffers();
@@ -122,6 +126,8 @@ namespace Strontium
     uint getRenderBufferID() { return this->depthBuffer.getID(); };
     uint getID() { return this->bufferID; }
   protected:
+    void clearIntegerAttachments();
+
     uint bufferID;
 
     std::map<FBOTargetParam, FBOAttachment> textureAttachments;
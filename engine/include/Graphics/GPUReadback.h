@@ -0,0 +1,95 @@
+#pragma once
+
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+#include "Graphics/FrameBuffer.h"
+
+namespace Strontium
+{
+  class ShaderStorageBuffer;
+
+  //----------------------------------------------------------------------------
+  // Asynchronous readback. Copies of GPU data are queued into a ring of
+  // staging buffers, each guarded by a fence, and read back once the GPU is
+  // done with them. Results lag a few frames behind but never stall.
+  //----------------------------------------------------------------------------
+  class AsynchReadback
+  {
+  public:
+    AsynchReadback(uint size, uint numBuffers);
+    ~AsynchReadback();
+
+    // Delete the copy constructor and the assignment operator. Prevents
+    // issues related to the underlying API.
+    AsynchReadback(const AsynchReadback&) = delete;
+    AsynchReadback(AsynchReadback&&) = delete;
+    AsynchReadback& operator=(const AsynchReadback&) = delete;
+    AsynchReadback& operator=(AsynchReadback&&) = delete;
+
+    // Queue a copy of size bytes of the source buffer, starting at offset.
+    // Returns false if every staging buffer is still in flight.
+    bool queueCopy(ShaderStorageBuffer &source, uint offset = 0u);
+
+    // Read the most recent completed copy into outData. Returns false if
+    // none of the queued copies have finished.
+    bool fetch(void* outData);
+
+    // Drop all the queued copies.
+    void reset();
+
+    uint getSize() const { return this->size; }
+  private:
+    const uint size;
+    uint start;
+    uint count;
+    const uint capacity;
+    uint* buffers;
+    void** fences;
+  };
+
+  //----------------------------------------------------------------------------
+  // Asynchronous pixel readback. Reads of framebuffer regions are queued into
+  // a ring of pixel buffers, each guarded by a fence. Unlike AsynchReadback
+  // every read is kept and they're resolved in the order they were queued.
+  //----------------------------------------------------------------------------
+  class AsynchPixelReadback
+  {
+  public:
+    AsynchPixelReadback(uint numBuffers);
+    ~AsynchPixelReadback();
+
+    // Delete the copy constructor and the assignment operator. Prevents
+    // issues related to the underlying API.
+    AsynchPixelReadback(const AsynchPixelReadback&) = delete;
+    AsynchPixelReadback(AsynchPixelReadback&&) = delete;
+    AsynchPixelReadback& operator=(const AsynchPixelReadback&) = delete;
+    AsynchPixelReadback& operator=(AsynchPixelReadback&&) = delete;
+
+    // Queue a read of a region of an unsigned integer attachment. The region
+    // is clamped to the framebuffer. Returns false if the clamped region is
+    // empty or every pixel buffer is still in flight.
+    bool queueRead(FrameBuffer &source, const FBOTargetParam &target,
+                   const glm::ivec2 &offset, const glm::ivec2 &extent);
+
+    // Read the oldest queued region into outData, row by row from the bottom
+    // left, and its offset (xy) and extent (zw) into outRegion. Returns false
+    // if it hasn't finished.
+    bool fetch(std::vector<uint> &outData, glm::ivec4 &outRegion);
+
+    // Drop all the queued reads.
+    void reset();
+
+    bool isFull() const { return this->count == this->capacity; }
+    uint getNumQueued() const { return this->count; }
+  private:
+    uint start;
+    uint count;
+    const uint capacity;
+    uint* buffers;
+    uint* bufferSizes;
+    void** fences;
+    glm::ivec4* regions;
+  };
+}
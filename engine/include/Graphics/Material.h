@@ -13,8 +13,13 @@
 
 #include "ShadingPrimatives.h"
 
+// STL includes.
+#include <functional>
+
 namespace Strontium
 {
+  class TextureBindCache;
+
   // Individual material class to hold shaders and shader data.
   class Material
   {
@@ -29,8 +34,14 @@ namespace Strontium
     Material(Type type = Type::PBR);
     ~Material();
 
-    // Prepare for drawing.
+    // Materials are registered by address, so they can't be copied.
+    Material(const Material &other) = delete;
+    Material& operator=(const Material &other) = delete;
+
+    // Prepare for drawing. The cached version skips textures which are 
+    // already bound.
     void configureTextures(bool bindOnlyAlbedo = false);
+    void configureTextures(TextureBindCache &cache, bool bindOnlyAlbedo = false);
 
     // Sampler configuration.
     bool hasSampler1D(const std::string &samplerName);
@@ -55,6 +66,18 @@ namespace Strontium
     // Get the shader program.
     Shader* getShader() { return this->program; }
 
+    // Dense ID of the material, reused once the material is destroyed. Used
+    // to sort draws and to index the GPU material table.
+    uint getID() const { return this->materialID; }
+
+    // Changes whenever a parameter is edited. Revisions are unique across all
+    // materials, so a reused ID never matches a stale revision.
+    uint getRevision() const { return this->revision; }
+
+    // Visit every live material. The registry is locked while visiting, so
+    // materials can't be created or destroyed from the visitor.
+    static void forEachMaterial(const std::function<void(Material*)> &visitor);
+
     // Get the shader data.
     float getfloat(const std::string &name)
     {
@@ -98,6 +121,7 @@ namespace Strontium
       if (loc->second != newFloat)
       {
           loc->second = newFloat;
+          this->markEdited();
       }
     }
 
@@ -107,6 +131,7 @@ namespace Strontium
         if (loc->second != newVec2)
         {
             loc->second = newVec2;
+            this->markEdited();
         }
     }
 
@@ -116,6 +141,7 @@ namespace Strontium
         if (loc->second != newVec3)
         {
             loc->second = newVec3;
+            this->markEdited();
         }
     }
 
@@ -125,6 +151,7 @@ namespace Strontium
         if (loc->second != newVec4)
         {
             loc->second = newVec4;
+            this->markEdited();
         }
     }
 
@@ -134,6 +161,7 @@ namespace Strontium
         if (loc->second != newMat3)
         {
             loc->second = newMat3;
+            this->markEdited();
         }
     }
 
@@ -143,6 +171,7 @@ namespace Strontium
         if (loc->second != newMat4)
         {
             loc->second = newMat4;
+            this->markEdited();
         }
     }
 
@@ -164,9 +193,14 @@ namespace Strontium
     // Reflect the attached shader.
     void reflect();
 
+    // Bump the revision after a parameter changed.
+    void markEdited();
+
     // The material type and pipeline.
     Type type;
     bool pipeline;
+    uint materialID;
+    uint revision;
 
     // The shader and shader data.
     Shader* program;
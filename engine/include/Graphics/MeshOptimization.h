@@ -0,0 +1,77 @@
+#pragma once
+
+// Macro include file.
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+
+namespace Strontium
+{
+  struct PackedVertex;
+
+  // Post-transform vertex cache statistics for an index buffer.
+  struct VertexCacheStatistics
+  {
+    uint numVerticesTransformed;
+    float acmr; // Average cache miss ratio (transformed vertices / triangles).
+    float atvr; // Average transform to vertex ratio (transformed vertices / vertices).
+
+    VertexCacheStatistics()
+      : numVerticesTransformed(0u)
+      , acmr(0.0f)
+      , atvr(0.0f)
+    { }
+  };
+
+  // Statistics for the import time optimization of a single mesh.
+  struct MeshOptimizationStatistics
+  {
+    VertexCacheStatistics before;
+    VertexCacheStatistics after;
+    uint numClusters;
+
+    MeshOptimizationStatistics()
+      : before()
+      , after()
+      , numClusters(0u)
+    { }
+  };
+}
+
+namespace Strontium::MeshOptimization
+{
+  // Size of the FIFO cache used to analyze vertex reuse.
+  constexpr uint analysisCacheSize = 16u;
+
+  // Simulate a FIFO post-transform cache to get the ACMR and ATVR of a triangle list.
+  VertexCacheStatistics analyzeVertexCache(const std::vector<uint> &indices, uint numVertices,
+                                           uint cacheSize = analysisCacheSize);
+
+  // Reorder triangles to improve post-transform vertex cache reuse. Uses
+  // Forsyth's linear-speed vertex cache optimization.
+  void optimizeVertexCache(std::vector<uint> &indices, uint numVertices);
+
+  // Reorder clusters of cache-optimized triangles so outward facing clusters
+  // are drawn first to reduce overdraw. The threshold controls how much the
+  // ACMR may degrade when splitting clusters. Returns the number of clusters.
+  uint optimizeOverdraw(std::vector<uint> &indices, const std::vector<PackedVertex> &vertices,
+                        float threshold = 1.05f);
+
+  // Reorder vertices in the order the index buffer references them, removing
+  // unreferenced vertices. Indices are remapped in place.
+  void optimizeVertexFetch(std::vector<PackedVertex> &vertices, std::vector<uint> &indices);
+
+  // Simplify a triangle list using quadric error metric edge collapses onto 
+  // existing vertices, so the result can share the vertex buffer of the 
+  // source. Attribute seams and open borders are preserved. Stops once the 
+  // target index count or the target error (object space distance) is reached.
+  // Returns the object space error of the result.
+  float simplify(std::vector<uint> &outIndices, const std::vector<uint> &indices,
+                 const std::vector<PackedVertex> &vertices, uint targetIndexCount,
+                 float targetError);
+
+  // Run all of the above in the right order on a triangle list.
+  MeshOptimizationStatistics optimizeMesh(std::vector<PackedVertex> &vertices,
+                                          std::vector<uint> &indices);
+}
@@ -6,6 +6,10 @@
 #include "Core/ApplicationBase.h"
 #include "Graphics/VertexArray.h"
 #include "Graphics/Shaders.h"
+#include "Graphics/MeshOptimization.h"
+#include "Graphics/Meshlets.h"
+
+#define MAX_MESH_LODS 4
 
 namespace Strontium
 {
@@ -67,6 +71,20 @@ namespace Strontium
     { }
   };
 
+  // A simplified level of detail for a mesh. Shares the vertices of the full 
+  // detail mesh.
+  struct MeshLOD
+  {
+    std::vector<uint> indices;
+    uint globalBufferLocation;
+    float error; // Object space error compared to the full detail mesh.
+
+    MeshLOD()
+      : globalBufferLocation(0u)
+      , error(0.0f)
+    { }
+  };
+
   class Mesh
   {
   public:
@@ -80,17 +98,39 @@ namespace Strontium
 
     // For rendering.
     bool init();
-    uint numToRender() const { return this->indices.size(); }
+    uint numToRender(uint lod = 0u) const { return lod == 0u ? this->indices.size() : this->lods[lod - 1u].indices.size(); }
     uint numVertices() const { return this->data.size(); }
-    void setGlobalLocation(uint globalLocation) { this->globalBufferLocation = globalLocation; }
-    uint getGlobalLocation() const { return this->globalBufferLocation; }
+    void setGlobalLocation(uint globalLocation, uint lod = 0u);
+    uint getGlobalLocation(uint lod = 0u) const { return lod == 0u ? this->globalBufferLocation : this->lods[lod - 1u].globalBufferLocation; }
+    void setGlobalVertexLocation(uint globalLocation) { this->globalVertexLocation = globalLocation; }
+    uint getGlobalVertexLocation() const { return this->globalVertexLocation; }
+
+    // Levels of detail. LOD 0 is the full detail mesh.
+    void generateLODs();
+    uint numLODs() const { return this->lods.size() + 1u; }
+    float getLODError(uint lod) const { return lod == 0u ? 0.0f : this->lods[lod - 1u].error; }
+    uint selectLOD(float pixelsPerUnit, float maxPixelError, float hysteresis, 
+                   uint previousLOD = 0u) const;
+
+    // Meshlets of the full detail mesh, used for cluster culling.
+    void generateMeshlets();
+    uint numMeshlets() const { return this->meshlets.size(); }
+    const std::vector<Meshlet>& getMeshlets() const { return this->meshlets; }
+    void setGlobalMeshletLocation(uint globalLocation) { this->globalMeshletLocation = globalLocation; }
+    uint getGlobalMeshletLocation() const { return this->globalMeshletLocation; }
 
     // Set the loaded state.
     void setLoaded(bool isLoaded) { this->loaded = isLoaded; }
 
+    // Reorder the mesh data for vertex cache efficiency and overdraw. Only
+    // done once, before the mesh is added to the global cache.
+    void optimize();
+    bool isOptimized() const { return this->optimized; }
+    const MeshOptimizationStatistics& getOptimizationStats() const { return this->optimizationStats; }
+
     // Getters.
     std::vector<PackedVertex>& getData() { return this->data; }
-    std::vector<uint>& getIndices() { return this->indices; }
+    std::vector<uint>& getIndices(uint lod = 0u) { return lod == 0u ? this->indices : this->lods[lod - 1u].indices; }
 
     glm::vec3 getMinPos() const { return this->minPos; }
     glm::vec3 getMaxPos() const { return this->maxPos; }
@@ -108,9 +148,16 @@ namespace Strontium
     bool loaded;
     bool skinned;
     bool drawable;
+    bool optimized;
     std::vector<PackedVertex> data;
     std::vector<uint> indices;
     uint globalBufferLocation;
+    uint globalVertexLocation;
+
+    std::vector<MeshLOD> lods;
+
+    std::vector<Meshlet> meshlets;
+    uint globalMeshletLocation;
 
     glm::vec3 minPos;
     glm::vec3 maxPos;
@@ -121,6 +168,8 @@ namespace Strontium
 
     UnloadedMaterialInfo materialInfo;
 
+    MeshOptimizationStatistics optimizationStats;
+
     Model* parent;
 
     friend class Model;
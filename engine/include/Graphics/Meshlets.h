@@ -0,0 +1,82 @@
+#pragma once
+
+// Macro include file.
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+#include "Core/Math.h"
+#include "Graphics/ShadingPrimatives.h"
+
+#define MAX_MESHLET_VERTICES 64
+#define MAX_MESHLET_TRIANGLES 124
+
+namespace Strontium
+{
+  struct PackedVertex;
+
+  // A small cluster of triangles. Meshlets are contiguous ranges of the
+  // parent mesh's index buffer so they can be drawn with drawArrays.
+  struct Meshlet
+  {
+    uint firstIndex; // Relative to the start of the mesh's indices.
+    uint numIndices;
+    uint numVertices;
+
+    // Local space bounding sphere.
+    glm::vec3 center;
+    float radius;
+
+    // Local space normal cone. A cutoff above 1 disables cone culling.
+    glm::vec3 coneAxis;
+    float coneCutoff;
+
+    Meshlet()
+      : firstIndex(0u)
+      , numIndices(0u)
+      , numVertices(0u)
+      , center(0.0f)
+      , radius(0.0f)
+      , coneAxis(0.0f, 0.0f, 1.0f)
+      , coneCutoff(2.0f)
+    { }
+  };
+
+  // Meshlet layout in the global meshlet cache.
+  struct GPUMeshlet
+  {
+    glm::vec4 boundingSphere; // Center (x, y, z) and radius (w).
+    glm::vec4 coneAxisCutoff; // Cone axis (x, y, z) and cutoff (w).
+    glm::uvec4 drawRange; // First index in the global index cache (x) and number of indices (y). z and w are unused.
+
+    GPUMeshlet(const Meshlet &meshlet, uint globalFirstIndex)
+      : boundingSphere(meshlet.center, meshlet.radius)
+      , coneAxisCutoff(meshlet.coneAxis, meshlet.coneCutoff)
+      , drawRange(globalFirstIndex + meshlet.firstIndex, meshlet.numIndices, 0u, 0u)
+    { }
+  };
+}
+
+namespace Strontium::Meshlets
+{
+  // Greedily split a triangle list into meshlets in index order. The index
+  // order is kept, so this should run after the vertex cache optimization.
+  std::vector<Meshlet> buildMeshlets(const std::vector<uint> &indices,
+                                     const std::vector<PackedVertex> &vertices,
+                                     uint maxVertices = MAX_MESHLET_VERTICES,
+                                     uint maxTriangles = MAX_MESHLET_TRIANGLES);
+
+  // CPU reference culling. Tests the meshlet against the frustum and rejects
+  // it if all of its triangles face away from the camera.
+  bool meshletVisible(const Meshlet &meshlet, const glm::mat4 &transform,
+                      const glm::mat3 &normalMatrix, float scale,
+                      const Frustum &frustum, const glm::vec3 &cameraPosition);
+
+  // Cull the meshlets of a mesh instance, appending draw commands for the
+  // visible meshlets. Adjacent meshlets share a command. Returns the number
+  // of visible meshlets.
+  uint cullMeshlets(const std::vector<Meshlet> &meshlets, const glm::mat4 &transform,
+                    const Frustum &frustum, const glm::vec3 &cameraPosition,
+                    uint globalFirstIndex, uint baseInstance,
+                    std::vector<DrawArraysIndirectCommand> &outCommands);
+}
@@ -58,6 +58,8 @@ namespace Strontium
     void processMesh(aiMesh* mesh, const aiScene* scene, const std::filesystem::path &directory, 
                      const glm::mat4& localTransform = glm::mat4(1.0f), bool isGLTF = false);
 
+    void optimizeSubmeshes();
+
     void addBoneData(unsigned int boneIndex, float boneWeight, PackedVertex &toMod);
 
     // Is the model loaded or not?
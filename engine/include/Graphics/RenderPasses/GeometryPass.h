@@ -4,13 +4,24 @@
 
 // Project includes.
 #include "Core/ApplicationBase.h"
+#include "Core/Math.h"
 #include "Graphics/RenderPasses/RenderPass.h"
 #include "Graphics/Model.h"
 #include "Graphics/Animations.h"
 #include "Graphics/Material.h"
+#include "Graphics/DrawSorting.h"
+#include "Graphics/TexturePages.h"
 #include "Graphics/GeometryBuffer.h"
 #include "Graphics/GPUTimers.h"
 
+// Entity component system includes.
+#include "entt.hpp"
+
+// Material textures bind to the first units, their texture pages to the
+// units after those.
+#define NUM_MATERIAL_TEXTURES 7
+#define TEXTURE_PAGE_UNIT_OFFSET 7
+
 namespace Strontium
 {
   namespace Renderer3D
@@ -18,57 +29,174 @@ namespace Strontium
   	struct GlobalRendererData;
   }
 
-  struct PerEntityData
+  struct GeomMeshData
+  {
+	DrawArraysIndirectCommand drawData;
+	Material* technique;
+
+	// Local space bounds of the submesh, used for GPU culling.
+	glm::vec3 boundsMin;
+	glm::vec3 boundsMax;
+
+	// Instances submitted this frame, and retained instances referenced by
+	// their entity slot.
+	std::vector<InstanceData> instanceData;
+	std::vector<uint> retainedInstances;
+
+	GeomMeshData(uint count, uint instanceCount, uint first, uint baseInstance, Material* technique,
+				 const glm::vec3 &boundsMin = glm::vec3(0.0f), const glm::vec3 &boundsMax = glm::vec3(0.0f))
+	  : drawData(count, instanceCount, first, baseInstance)
+	  , technique(technique)
+	  , boundsMin(boundsMin)
+	  , boundsMax(boundsMax)
+	{ }
+  };
+
+  // A static renderable which persists between frames. The entity data of its
+  // submeshes lives in the retained entity buffer, one slot per submesh, and
+  // is only uploaded again when the proxy changes. Every submesh has its
+  // transform in its slot, even if it has no material, so other passes can
+  // draw the proxy out of the same buffer.
+  struct GeomRenderProxy
   {
+	Model* model;
 	glm::mat4 transform;
-	glm::vec4 idMask;
-	MaterialBlockData materialData;
-
-	PerEntityData(const glm::mat4 &transform, const glm::vec4 &idMask,
-				  const MaterialBlockData& materialData)
-	  : transform(transform)
-	  , idMask(idMask)
-	  , materialData(materialData)
+	glm::uvec4 ids;
+
+	std::vector<Material*> techniques;
+	std::vector<uint> entitySlots;
+
+	// Set when the entity slots were reallocated.
+	bool dirty;
+
+	GeomRenderProxy()
+	  : model(nullptr)
+	  , transform(1.0f)
+	  , ids(0u)
+	  , dirty(false)
 	{ }
   };
 
-  struct GeomMeshData
+  // A retained instance prepared for drawing.
+  struct GeomProxyInstance
   {
-	DrawArraysIndirectCommand drawData;
+	Model* model;
 	Material* technique;
-	bool draw;
-
-	std::vector<PerEntityData> instanceData;
+	uint submesh;
+	uint lod;
+	uint entitySlot;
 
-	GeomMeshData(uint count, uint instanceCount, uint first, uint baseInstance, Material* technique)
-	  : drawData(count, instanceCount, first, baseInstance)
+	GeomProxyInstance(Model* model, Material* technique, uint submesh, uint lod, uint entitySlot)
+	  : model(model)
 	  , technique(technique)
-	  , draw(false)
+	  , submesh(submesh)
+	  , lod(lod)
+	  , entitySlot(entitySlot)
 	{ }
   };
 
+  // A run of static draw commands which share a material. Drawn with a
+  // single multi-draw.
+  struct GeomMaterialBucket
+  {
+	Material* technique;
+	uint commandOffset;
+	uint numCommands;
+
+	GeomMaterialBucket(Material* technique, uint commandOffset)
+	  : technique(technique)
+	  , commandOffset(commandOffset)
+	  , numCommands(0u)
+	{ }
+  };
+
+  // A static instance culled on the GPU.
+  struct GPUInstanceJob
+  {
+	glm::vec4 boundsMin; // Local space AABB minimum (x, y, z). w is unused.
+	glm::vec4 boundsMax; // Local space AABB maximum (x, y, z). w is unused.
+	glm::uvec4 indices; // Entity index (x), draw command index (y) and retained (z). w is unused.
+
+	GPUInstanceJob(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, uint entityIndex, 
+				   uint commandIndex, bool retained)
+	  : boundsMin(boundsMin, 0.0f)
+	  , boundsMax(boundsMax, 0.0f)
+	  , indices(entityIndex, commandIndex, retained ? 1u : 0u, 0u)
+	{ }
+  };
+
+  // A skinned submesh. The offset points into the skinned index buffer of
+  // the skinning pass.
   struct GeomDynamicDrawData
   {
 	Material* technique;
-	Animator* animations;
 
 	uint numToRender;
 	uint globalBufferOffset;
 
-	PerEntityData data;
+	InstanceData data;
 
 	uint instanceCount;
 
 	GeomDynamicDrawData(uint globalBufferOffset, Material* technique,
-						uint numToRender, Animator* animations, const PerEntityData &data)
+						uint numToRender, const InstanceData &data)
 	  : globalBufferOffset(globalBufferOffset)
       , technique(technique)
 	  , numToRender(numToRender)
-	  , animations(animations)
 	  , data(data)
 	  , instanceCount(1)
 	{ }
   };
+
+  // A single mesh instance drawn as meshlets with one indirect command per
+  // visible meshlet.
+  struct GeomClusteredDrawData
+  {
+	const Mesh* mesh;
+	Material* technique;
+
+	InstanceData data;
+
+	uint commandOffset;
+	uint numCommands;
+
+	GeomClusteredDrawData(const Mesh* mesh, Material* technique, const InstanceData &data)
+	  : mesh(mesh)
+	  , technique(technique)
+	  , data(data)
+	  , commandOffset(0u)
+	  , numCommands(0u)
+	{ }
+  };
+
+  // Retained submissions prepared off the main thread. Each job fills its own
+  // buffer, the buffers are then merged into the draw lists in order.
+  struct GeomSubmissionBuffer
+  {
+	std::vector<GeomProxyInstance> instances;
+	std::vector<GeomClusteredDrawData> clusteredDraws;
+	std::vector<uint> dirtySlots;
+
+	uint numTrianglesSubmitted;
+	uint numTrianglesLODReduced;
+	uint numClustersSubmitted;
+
+	GeomSubmissionBuffer()
+	  : numTrianglesSubmitted(0u)
+	  , numTrianglesLODReduced(0u)
+	  , numClustersSubmitted(0u)
+	{ }
+
+	void clear()
+	{
+	  this->instances.clear();
+	  this->clusteredDraws.clear();
+	  this->dirtySlots.clear();
+	  this->numTrianglesSubmitted = 0u;
+	  this->numTrianglesLODReduced = 0u;
+	  this->numClustersSubmitted = 0u;
+	}
+  };
 }
 
 namespace Strontium
@@ -77,24 +205,95 @@ namespace Strontium
   {
 	// Required buffers and lists to draw stuff.
 	GeometryBuffer gBuffer;
-	FrameBuffer idMaskBuffer;
 
 	Shader* staticGeometryPass;
-	Shader* dynamicGeometryPass;
-	Shader* staticEditorPass;
-	Shader* dynamicEditorPass;
+	Shader* meshletCulling;
+	Shader* instanceCulling;
 
 	UniformBuffer perDrawUniforms;
+	UniformBuffer clusterCullingUniforms;
+	UniformBuffer instanceCullingUniforms;
 
 	ShaderStorageBuffer entityDataBuffer;
-	ShaderStorageBuffer boneBuffer;
+	ShaderStorageBuffer clusterJobBuffer;
+	DrawIndirectBuffer clusterCommandBuffer;
+	ShaderStorageBuffer instanceJobBuffer;
+	ShaderStorageBuffer visibleEntityDataBuffer;
+	ShaderStorageBuffer retainedEntityBuffer;
+	DrawIndirectBuffer staticCommandBuffer;
+	DrawIndirectBuffer skinnedCommandBuffer;
+	ShaderStorageBuffer materialBuffer;
 
+	// The instances submitted this frame, uploaded at once into the entity
+	// data buffer.
 	uint numUniqueEntities;
+	std::vector<InstanceData> frameInstances;
 	robin_hood::unordered_flat_map<Model*, uint> modelMap;
 	std::vector<GeomMeshData> staticGeometry;
+	std::vector<uint> staticDrawOrder;
+	std::vector<GeomMaterialBucket> materialBuckets;
+	std::vector<DrawArraysIndirectCommand> staticCommands;
+	std::vector<GPUInstanceJob> instanceJobs;
+
+	// Retained render proxies and the CPU copy of their entity data. Only
+	// the dirty entity slots are uploaded each frame.
+	std::vector<GeomRenderProxy> renderProxies;
+	std::stack<RendererDataHandle> availableProxies;
+	std::vector<InstanceData> retainedEntityData;
+	std::vector<uint> availableEntitySlots;
+	std::vector<uint> dirtyEntitySlots;
+	// The compiled material parameters indexed by material ID, and the
+	// revision of each entry. Only edited materials are uploaded.
+	std::vector<MaterialBlockData> materialTable;
+	std::vector<uint> materialRevisions;
+	std::vector<uint> dirtyMaterials;
+	// Skinned submeshes are drawn like static geometry out of the skinning
+	// pass' buffers, bucketed by material.
 	std::vector<GeomDynamicDrawData> dynamicDrawList;
-	bool drawingIDs;
-	bool drawingMask;
+	std::vector<GeomMaterialBucket> skinnedBuckets;
+	std::vector<DrawArraysIndirectCommand> skinnedCommands;
+	std::vector<GeomClusteredDrawData> clusteredDrawList;
+	std::vector<DrawArraysIndirectCommand> clusterCommands;
+
+	// Draws are sorted by material and then front to back. Redundant texture
+	// binds are skipped while drawing.
+	std::vector<SortedDraw> drawKeys;
+	std::vector<SortedDraw> drawKeysScratch;
+	TextureBindCache textureBindCache;
+
+	// Material textures copied into texture array pages. Materials with
+	// every texture paged are grouped by the pages they use, and a group is
+	// drawn with a single bind. Other materials are their own group.
+	// Materials are only re-paged when they're edited or when a texture
+	// changed since the last frame.
+	TexturePageCache texturePages;
+	uint pagedTextureRevision;
+	bool pagedWithTexturePaging;
+	std::vector<uint> materialBindingGroups;
+	std::vector<std::array<uint, NUM_MATERIAL_TEXTURES>> texturePageSets;
+	robin_hood::unordered_flat_map<ulong, uint> texturePageSetIDs;
+	uint boundBindingGroup;
+
+	AABBBatch cullingBatch;
+	std::vector<uint> cullingVisibility;
+
+	// Cluster culling settings. Full detail submeshes with at least 
+	// clusterCullingMinMeshlets meshlets are culled per meshlet.
+	bool clusterCulling;
+	bool gpuClusterCulling;
+	uint clusterCullingMinMeshlets;
+
+	// GPU instance culling settings. Static instances are culled against the
+	// frustum and the previous frame's Hi-Z buffer in a compute shader. When
+	// disabled the compute shader only compacts the instances.
+	bool gpuInstanceCulling;
+	bool hiZOcclusionCulling;
+
+	// Sort the draws within each material front to back for early-z.
+	bool depthSortDraws;
+
+	// Page material textures so different materials can share draws.
+	bool texturePaging;
 
 	// Some statistics to display.
 	float frameTime;
@@ -102,25 +301,58 @@ namespace Strontium
 	uint numDrawCalls;
 	uint numTrianglesSubmitted;
 	uint numTrianglesDrawn;
+	uint numTrianglesLODReduced;
+	uint numClustersSubmitted;
+	uint numClustersCulled;
+	uint numRetainedUploads;
+	uint numMaterialUploads;
+	uint numTextureBinds;
+	uint numTextureBindsSkipped;
+	uint numMaterialBindsSkipped;
+	uint numPagedMaterials;
 	
 	GeometryPassDataBlock()
 	  : gBuffer(1600u, 900u)
-	  , idMaskBuffer(1600u, 900u)
 	  , staticGeometryPass(nullptr)
-	  , dynamicGeometryPass(nullptr)
-	  , staticEditorPass(nullptr)
-	  , dynamicEditorPass(nullptr)
+	  , meshletCulling(nullptr)
+	  , instanceCulling(nullptr)
 	  , perDrawUniforms(sizeof(int), BufferType::Dynamic)
+	  , clusterCullingUniforms(7 * sizeof(glm::vec4), BufferType::Dynamic)
+	  , instanceCullingUniforms(sizeof(glm::mat4) + 7 * sizeof(glm::vec4), BufferType::Dynamic)
 	  , entityDataBuffer(0, BufferType::Dynamic)
-	  , boneBuffer(MAX_BONES_PER_MODEL * sizeof(glm::mat4), BufferType::Dynamic)
+	  , clusterJobBuffer(0, BufferType::Dynamic)
+	  , clusterCommandBuffer(0u, BufferType::Dynamic)
+	  , instanceJobBuffer(0, BufferType::Dynamic)
+	  , visibleEntityDataBuffer(0, BufferType::Dynamic)
+	  , retainedEntityBuffer(0, BufferType::Dynamic)
+	  , staticCommandBuffer(0u, BufferType::Dynamic)
+	  , skinnedCommandBuffer(0u, BufferType::Dynamic)
+	  , materialBuffer(0, BufferType::Dynamic)
 	  , numUniqueEntities(0u)
-	  , drawingIDs(false)
-	  , drawingMask(false)
+	  , pagedTextureRevision(std::numeric_limits<uint>::max())
+	  , pagedWithTexturePaging(false)
+	  , boundBindingGroup(std::numeric_limits<uint>::max())
+	  , clusterCulling(true)
+	  , gpuClusterCulling(true)
+	  , clusterCullingMinMeshlets(16u)
+	  , gpuInstanceCulling(true)
+	  , hiZOcclusionCulling(true)
+	  , depthSortDraws(true)
+	  , texturePaging(true)
 	  , frameTime(0.0f)
 	  , numInstances(0u)
 	  , numDrawCalls(0u)
 	  , numTrianglesSubmitted(0u)
 	  , numTrianglesDrawn(0u)
+	  , numTrianglesLODReduced(0u)
+	  , numClustersSubmitted(0u)
+	  , numClustersCulled(0u)
+	  , numRetainedUploads(0u)
+	  , numMaterialUploads(0u)
+	  , numTextureBinds(0u)
+	  , numTextureBindsSkipped(0u)
+	  , numMaterialBindsSkipped(0u)
+	  , numPagedMaterials(0u)
 	{ }
   };
 
@@ -139,12 +371,51 @@ namespace Strontium
 	void onRendererEnd(FrameBuffer& frontBuffer) override;
 	void onShutdown() override;
 
+	// The selected LODs of the submeshes are read and written to selectedLODs
+	// if provided, used for LOD hysteresis. Submeshes are frustum culled
+	// unless the visibility is provided by the scene.
 	void submit(Model* data, ModelMaterial &materials, const glm::mat4 &model,
-                float id = -1.0f, bool drawSelectionMask = false);
+                entt::entity id = entt::null, bool drawSelectionMask = false,
+                std::vector<uint>* selectedLODs = nullptr,
+                const std::vector<bool>* visibleSubmeshes = nullptr);
     void submit(Model* data, Animator* animation, ModelMaterial& materials,
-                const glm::mat4 &model, float id = -1.0f,
-                bool drawSelectionMask = false);
+                const glm::mat4 &model, entt::entity id = entt::null,
+                bool drawSelectionMask = false, std::vector<uint>* selectedLODs = nullptr);
+
+	// Retained static renderables. Handles come from requestRendererData().
+	// Updating a proxy only touches the entity data if something changed.
+	// Proxies can be updated and prepared in parallel into per-thread 
+	// submission buffers, which are then merged in order.
+	bool setProxyModel(RendererDataHandle handle, Model* data);
+	void updateProxy(RendererDataHandle handle, ModelMaterial &materials, const glm::mat4 &model, 
+	                 entt::entity id, bool drawSelectionMask, GeomSubmissionBuffer &buffer);
+	void prepareSubmit(RendererDataHandle handle, std::vector<uint>* selectedLODs,
+	                   const std::vector<bool>* visibleSubmeshes, GeomSubmissionBuffer &buffer);
+	void mergeSubmissions(GeomSubmissionBuffer &buffer);
+
+	// The entity slots of a proxy's submeshes if it currently draws the
+	// model, otherwise nullptr. The retained entity buffer is uploaded when
+	// this pass renders, passes which run after it can bind it to draw the
+	// proxies without uploading their transforms again.
+	const std::vector<uint>* getProxyEntitySlots(RendererDataHandle handle, Model* data) const;
+	void bindRetainedEntities(uint bindPoint);
   private:
+	uint getStaticDrawSlots(Model* data);
+	void submitStatic(Model* data, ModelMaterial &materials, const glm::mat4 &model,
+	                  robin_hood::unordered_flat_map<std::string, glm::mat4>* riggedTransforms,
+	                  entt::entity id, bool drawSelectionMask, std::vector<uint>* selectedLODs,
+	                  const std::vector<bool>* visibleSubmeshes);
+	void uploadRetainedEntities();
+	void uploadMaterials();
+	uint buildStaticCommands();
+	void cullInstances();
+	void drawStaticBuckets();
+	void buildSkinnedCommands(uint firstSkinnedEntity);
+	void drawSkinnedBuckets();
+	void resetBoundState();
+	void bindMaterial(Material* material);
+	void cullClusters(uint firstClusteredEntity);
+
 	GeometryPassDataBlock passData;
 
 	AsynchTimer timer;
@@ -23,6 +23,11 @@ namespace Strontium
 
     Texture2D hierarchicalDepth;
 
+    // Set once the hierarchical depth holds a complete frame, cleared on
+    // resize. Used for culling with the previous frame's depth.
+    bool valid;
+    uint numValidMips;
+
     // Some statistics to display.
     
     float frameTime;
@@ -30,6 +35,8 @@ namespace Strontium
     HiZPassDataBlock()
       : depthCopy(nullptr)
       , depthReduction(nullptr)
+      , valid(false)
+      , numValidMips(0u)
       , frameTime(0.0f)
     { }
   };
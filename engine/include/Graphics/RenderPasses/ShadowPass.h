@@ -2,6 +2,10 @@
 
 #define NUM_CASCADES 4
 
+// Caster instances with this bit set are in the shadow pass' own instance
+// buffer, otherwise they're retained entity slots of the geometry pass.
+#define SHADOW_LOCAL_INSTANCE 0x80000000u
+
 // Project includes.
 #include "Core/ApplicationBase.h"
 #include "Core/Math.h"
@@ -9,6 +13,7 @@
 #include "Graphics/Model.h"
 #include "Graphics/Animations.h"
 #include "Graphics/GPUTimers.h"
+#include "Graphics/GPUReadback.h"
 
 namespace Strontium
 {
@@ -21,34 +26,92 @@ namespace Strontium
   {
 	DrawArraysIndirectCommand drawData;
 
+	// Local space bounds of the submesh.
+	glm::vec3 boundsMin;
+	glm::vec3 boundsMax;
+
+	// The transform and retained entity slot of each instance. The slot is
+	// SHADOW_LOCAL_INSTANCE if the shadow pass uploads the instance itself.
 	std::vector<glm::mat4> instanceTransforms;
+	std::vector<uint> instanceSlots;
 
-	ShadowMeshData(uint count, uint instanceCount, uint first, uint baseInstance)
+	ShadowMeshData(uint count, uint instanceCount, uint first, uint baseInstance,
+	               const glm::vec3 &boundsMin = glm::vec3(0.0f),
+	               const glm::vec3 &boundsMax = glm::vec3(0.0f))
 	  : drawData(count, instanceCount, first, baseInstance)
+	  , boundsMin(boundsMin)
+	  , boundsMax(boundsMax)
 	{ }
   };
 
+  // An animated submesh. The offset points into the skinned index buffer of
+  // the skinning pass if the submesh is skinned, otherwise into the global
+  // index cache.
   struct ShadowDynamicDrawData
   {
 	uint numToRender;
 	uint globalBufferOffset;
 
-	Animator* animations;
-
 	glm::mat4 transform;
+	glm::vec3 boundsMin;
+	glm::vec3 boundsMax;
 
 	uint instanceCount;
+	bool skinned;
 
 	ShadowDynamicDrawData(uint globalBufferOffset, uint numToRender,
-		                  Animator* animations,
-					      const glm::mat4 &transform)
+					      const glm::mat4 &transform,
+	                      const glm::vec3 &boundsMin,
+	                      const glm::vec3 &boundsMax,
+	                      bool skinned = true)
 	  : globalBufferOffset(globalBufferOffset)
 	  , numToRender(numToRender)
-	  , animations(animations)
 	  , transform(transform)
+	  , boundsMin(boundsMin)
+	  , boundsMax(boundsMax)
 	  , instanceCount(1)
+	  , skinned(skinned)
+	{ }
+  };
+
+  // A static caster submesh recorded by a parallel submission.
+  struct ShadowCasterInstance
+  {
+	Model* model;
+	uint submesh;
+	uint lod;
+	uint entitySlot;
+	glm::mat4 transform;
+
+	ShadowCasterInstance(Model* model, uint submesh, uint lod, uint entitySlot, const glm::mat4 &transform)
+	  : model(model)
+	  , submesh(submesh)
+	  , lod(lod)
+	  , entitySlot(entitySlot)
+	  , transform(transform)
 	{ }
   };
+
+  // The static casters recorded by one batch of a parallel submission. Each
+  // batch writes to its own buffer, the buffers are merged in batch order.
+  struct ShadowSubmissionBuffer
+  {
+	std::vector<ShadowCasterInstance> instances;
+	glm::vec3 minPos;
+	glm::vec3 maxPos;
+
+	ShadowSubmissionBuffer()
+	  : minPos(std::numeric_limits<float>::max())
+	  , maxPos(std::numeric_limits<float>::lowest())
+	{ }
+
+	void clear()
+	{
+	  this->instances.clear();
+	  this->minPos = glm::vec3(std::numeric_limits<float>::max());
+	  this->maxPos = glm::vec3(std::numeric_limits<float>::lowest());
+	}
+  };
 }
 
 namespace Strontium
@@ -56,10 +119,11 @@ namespace Strontium
   struct ShadowPassDataBlock
   {
 	FrameBuffer shadowBuffer;
+	FrameBuffer staticCacheBuffer;
 	DrawIndirectBuffer indirectBuffer;
 
 	Shader* staticShadow;
-	Shader* dynamicShadow;
+	Shader* depthBounds;
 
 	// Shadow view-projection calculation information.
 	float cascadeLambda;
@@ -67,20 +131,31 @@ namespace Strontium
 	bool hasCascades;
 	glm::vec4 cascadeSplits[NUM_CASCADES];
 
+	// Sample distribution shadow maps. The cascades are fit to the depth
+	// range of the visible geometry instead of the full near/far range. The
+	// range is reduced from the hierarchical depth and read back a few
+	// frames late, so it's padded by a fraction of itself.
+	bool useSDSM;
+	float sdsmPadding;
+	ShaderStorageBuffer depthBoundsBuffer;
+	AsynchReadback depthBoundsReadback;
+	bool hasDepthBounds;
+	glm::vec2 visibleDepthRange;
+
 	// The primary light.
 	bool castShadows;
 	DirectionalLight primaryLight;
 	// The pseudo-cameras for the shadow pass.
 	glm::mat4 cascades[NUM_CASCADES];
+	// The cascade volumes used to cull casters. The near plane is extruded
+	// toward the light to the edge of the scene and the far plane is pulled
+	// in to the furthest receiver in the cascade.
 	Frustum lightCullingFrustums[NUM_CASCADES];
 
 	// Required buffers and lists to draw stuff.
 	UniformBuffer lightSpaceBuffer;
-	UniformBuffer perDrawUniforms;
 
-	ShaderStorageBuffer transformBuffer;
-	ShaderStorageBuffer drawIDToTransformMap;
-	ShaderStorageBuffer boneBuffer;
+	ShaderStorageBuffer instanceBuffer;
 
 	uint numUniqueEntities;
 	uint numUniqueStaticMeshes;
@@ -89,6 +164,43 @@ namespace Strontium
 	robin_hood::unordered_flat_map<Model*, uint> modelMap;
 	std::vector<ShadowMeshData> staticGeometry;
 	std::vector<ShadowDynamicDrawData> dynamicDrawList;
+	ShadowSubmissionBuffer submissionScratch;
+
+	// Per cascade caster culling. Every caster gets a mask of the cascades
+	// it survived culling in, and all the cascades are drawn in one pass
+	// with the geometry shader routing triangles to the cascade viewports.
+	// Animated casters come after the static commands and aren't cached.
+	// Rigidly animated submeshes are drawn out of the global caches first,
+	// then skinned casters out of the skinning pass' buffers. Each drawn
+	// instance is a reference to its instance data (x) and its cascade mask
+	// (y). Retained casters point at the geometry pass' entity slots, only
+	// the other casters have their instance data uploaded by this pass.
+	bool casterCulling;
+	AABBBatch casterBounds;
+	std::vector<uint> casterVisibility[NUM_CASCADES];
+	std::vector<uint> casterMasks;
+	std::vector<InstanceData> localInstances;
+	std::vector<glm::uvec2> casterInstances;
+	std::vector<DrawArraysIndirectCommand> casterCommands;
+	ShaderStorageBuffer casterInstanceBuffer;
+	ulong cascadeCasterHashes[NUM_CASCADES];
+
+	// Static shadow caching. Static casters are drawn once into a cached
+	// depth map per cascade, which is copied into the shadow map before the
+	// dynamic casters each frame. A cascade's cache is invalidated when its
+	// light-space matrix or the static casters in its volume change.
+	bool cacheStaticShadows;
+	bool cascadeCacheValid[NUM_CASCADES];
+	glm::mat4 cachedCascades[NUM_CASCADES];
+	ulong cachedCasterHashes[NUM_CASCADES];
+
+	// Cascades starting at firstStaggeredCascade are only redrawn once every
+	// staggerInterval frames, offset so they don't update on the same frame.
+	uint firstStaggeredCascade;
+	uint staggerInterval;
+	ulong frameCount;
+	bool cascadeRendered[NUM_CASCADES];
+	glm::mat4 renderedCascades[NUM_CASCADES];
 
 	// Shadow settings.
 	uint shadowQuality;
@@ -105,27 +217,47 @@ namespace Strontium
 	uint numInstances;
 	uint numDrawCalls;
 	uint numTrianglesDrawn;
+	uint numCastersCulled;
+	uint cascadeInstances[NUM_CASCADES];
+	uint cascadeTriangles[NUM_CASCADES];
+	uint numCachedCascades;
+	uint numStaggeredCascades;
 
 	ShadowPassDataBlock()
 	  : staticShadow(nullptr)
-	  , dynamicShadow(nullptr)
+	  , depthBounds(nullptr)
 	  , cascadeLambda(0.5f)
 	  , shadowMapRes(2048)
 	  , hasCascades(false)
 	  , cascadeSplits()
+	  , useSDSM(false)
+	  , sdsmPadding(0.1f)
+	  , depthBoundsBuffer(2u * sizeof(uint), BufferType::Dynamic)
+	  , depthBoundsReadback(2u * sizeof(uint), 3u)
+	  , hasDepthBounds(false)
+	  , visibleDepthRange(0.0f)
 	  , cascades()
 	  , lightCullingFrustums()
 	  , castShadows(false)
-	  , lightSpaceBuffer(sizeof(glm::mat4), BufferType::Dynamic)
-	  , perDrawUniforms(sizeof(int), BufferType::Dynamic)
-	  , transformBuffer(0u, BufferType::Dynamic)
-	  , drawIDToTransformMap(0u, BufferType::Dynamic)
-	  , boneBuffer(MAX_BONES_PER_MODEL * sizeof(glm::mat4), BufferType::Dynamic)
+	  , lightSpaceBuffer(NUM_CASCADES * sizeof(glm::mat4), BufferType::Dynamic)
+	  , instanceBuffer(0u, BufferType::Dynamic)
 	  , indirectBuffer(0u, BufferType::Dynamic)
 	  , numUniqueEntities(0u)
 	  , numUniqueStaticMeshes(0u)
 	  , minPos(std::numeric_limits<float>::max())
 	  , maxPos(std::numeric_limits<float>::min())
+	  , casterCulling(true)
+	  , casterInstanceBuffer(0u, BufferType::Dynamic)
+	  , cascadeCasterHashes()
+	  , cacheStaticShadows(true)
+	  , cascadeCacheValid()
+	  , cachedCascades()
+	  , cachedCasterHashes()
+	  , firstStaggeredCascade(2u)
+	  , staggerInterval(1u)
+	  , frameCount(0u)
+	  , cascadeRendered()
+	  , renderedCascades()
 	  , shadowQuality(0)
 	  , useSSShadows(true)
 	  , numSearchSteps(16u)
@@ -138,6 +270,11 @@ namespace Strontium
 	  , numInstances(0u)
 	  , numDrawCalls(0u)
 	  , numTrianglesDrawn(0u)
+	  , numCastersCulled(0u)
+	  , cascadeInstances()
+	  , cascadeTriangles()
+	  , numCachedCascades(0u)
+	  , numStaggeredCascades(0u)
 	{ }
   };
 
@@ -156,11 +293,29 @@ namespace Strontium
 	void onRendererEnd(FrameBuffer& frontBuffer) override;
 	void onShutdown() override;
 
-	void submit(Model* data, const glm::mat4 &model);
-	void submit(Model* data, Animator* animation, const glm::mat4& model);
+	// Uses the LODs the geometry pass selected if provided, otherwise selects
+	// them from the camera. Static models with a geometry pass proxy are
+	// drawn out of its retained entity slots.
+	void submit(Model* data, const glm::mat4 &model, const std::vector<uint>* selectedLODs = nullptr,
+	            RendererDataHandle geometryHandle = -1);
+	void submit(Model* data, Animator* animation, const glm::mat4& model,
+	            const std::vector<uint>* selectedLODs = nullptr);
+
+	// Parallel static submission. prepareSubmit() records a model's casters
+	// into a submission buffer and is safe to call concurrently with
+	// different buffers. The model must already be drawable. Merge the
+	// buffers in a fixed order afterward.
+	void prepareSubmit(Model* data, const glm::mat4 &model, const std::vector<uint>* selectedLODs,
+	                   RendererDataHandle geometryHandle, ShadowSubmissionBuffer &buffer);
+	void mergeSubmissions(ShadowSubmissionBuffer &buffer);
 	void submitPrimary(const DirectionalLight &primaryLight, bool castShadows, const glm::mat4 &model);
   private:
+	uint getStaticDrawSlots(Model* data);
 	void computeShadowData();
+	void cullCasters();
+	uint buildCasterDraws(uint staticMask, uint dynamicMask, uint &outNumRigidCommands);
+	void invalidateCascades();
+	void reduceDepthBounds();
 
 	ShadowPassDataBlock passData;
 
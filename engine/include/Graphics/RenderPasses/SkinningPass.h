@@ -0,0 +1,143 @@
+#pragma once
+
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+#include "Graphics/RenderPasses/RenderPass.h"
+#include "Graphics/Meshes.h"
+#include "Graphics/Animations.h"
+#include "Graphics/Shaders.h"
+#include "Graphics/GPUTimers.h"
+
+namespace Strontium
+{
+  namespace Renderer3D
+  {
+    struct GlobalRendererData;
+  }
+
+  // The skinned vertices of a submesh posed by an animator.
+  struct SkinnedMeshData
+  {
+    const Mesh* mesh;
+    uint firstVertex;
+
+    SkinnedMeshData(const Mesh* mesh, uint firstVertex)
+      : mesh(mesh)
+      , firstVertex(firstVertex)
+    { }
+  };
+
+  // The rebased indices of one LOD of a skinned submesh.
+  struct SkinnedLODData
+  {
+    const Mesh* mesh;
+    uint lod;
+    uint firstIndex;
+
+    SkinnedLODData(const Mesh* mesh, uint lod, uint firstIndex)
+      : mesh(mesh)
+      , lod(lod)
+      , firstIndex(firstIndex)
+    { }
+  };
+
+  // A pose with skinning requests this frame and the offset of its bone
+  // palette. Poses only ever skin a handful of submeshes, so the lists are
+  // searched linearly.
+  struct SkinnedAnimatorData
+  {
+    uint boneOffset;
+    std::vector<SkinnedMeshData> meshes;
+    std::vector<SkinnedLODData> lods;
+
+    SkinnedAnimatorData(uint boneOffset)
+      : boneOffset(boneOffset)
+    { }
+  };
+
+  struct SkinningPassDataBlock
+  {
+    Shader* skinVertices;
+    Shader* remapIndices;
+
+    // The bone palettes of all the poses, uploaded at once.
+    ShaderStorageBuffer boneBuffer;
+    ShaderStorageBuffer vertexJobBuffer;
+    ShaderStorageBuffer indexJobBuffer;
+
+    // Transient skinned geometry, laid out like the global vertex and index
+    // caches. Valid for the frame after this pass runs.
+    ShaderStorageBuffer skinnedVertices;
+    ShaderStorageBuffer skinnedIndices;
+
+    // Poses are keyed by their palette, which animators playing the same
+    // clip at the same time share.
+    robin_hood::unordered_flat_map<const glm::mat4*, uint> animatorMap;
+    std::vector<SkinnedAnimatorData> animators;
+    std::vector<glm::mat4> bonePalettes;
+    std::vector<glm::uvec4> vertexJobs;
+    std::vector<glm::uvec4> indexJobs;
+
+    uint numSkinnedVertices;
+    uint numSkinnedIndices;
+    uint maxJobVertices;
+    uint maxJobIndices;
+
+    // Some statistics to display.
+    float frameTime;
+    uint numPoses;
+    uint numSkinnedMeshes;
+    uint numSkinnedLODs;
+
+    SkinningPassDataBlock()
+      : skinVertices(nullptr)
+      , remapIndices(nullptr)
+      , boneBuffer(0u, BufferType::Dynamic)
+      , vertexJobBuffer(0u, BufferType::Dynamic)
+      , indexJobBuffer(0u, BufferType::Dynamic)
+      , skinnedVertices(0u, BufferType::Dynamic)
+      , skinnedIndices(0u, BufferType::Dynamic)
+      , numSkinnedVertices(0u)
+      , numSkinnedIndices(0u)
+      , maxJobVertices(0u)
+      , maxJobIndices(0u)
+      , frameTime(0.0f)
+      , numPoses(0u)
+      , numSkinnedMeshes(0u)
+      , numSkinnedLODs(0u)
+    { }
+  };
+
+  // Skins every visible animated submesh once per frame with compute
+  // shaders. Runs before the passes which draw geometry, which then draw the
+  // skinned meshes as static geometry out of the skinned buffers.
+  class SkinningPass final : public RenderPass
+  {
+  public:
+    SkinningPass(Renderer3D::GlobalRendererData* globalRendererData);
+    ~SkinningPass() override;
+
+    void onInit() override;
+    void updatePassData() override;
+    RendererDataHandle requestRendererData() override;
+    void deleteRendererData(RendererDataHandle& handle) override;
+    void onRendererBegin(uint width, uint height) override;
+    void onRender() override;
+    void onRendererEnd(FrameBuffer& frontBuffer) override;
+    void onShutdown() override;
+
+    // Request a submesh LOD posed by an animator. Returns the first index of
+    // the LOD in the skinned index buffer. Requests for the same pose are
+    // shared between all the passes which make them.
+    uint submit(const Mesh &submesh, uint lod, Animator* animation);
+
+    // Bind the skinned buffers in place of the global vertex and index caches.
+    void bindSkinnedCaches(uint vertexPoint, uint indexPoint);
+  private:
+    SkinningPassDataBlock passData;
+
+    AsynchTimer timer;
+  };
+}
@@ -35,6 +35,7 @@ namespace Strontium::Renderer3D
 
     ShaderStorageBuffer vertexCache;
     ShaderStorageBuffer indexCache;
+    ShaderStorageBuffer meshletCache;
     ShaderStorageBuffer transferBuffer;
     VertexArray blankVAO;
 
@@ -45,9 +46,22 @@ namespace Strontium::Renderer3D
     Texture2D halfResBuffer1;
     Texture2D fullResBuffer1;
 
+    // LOD selection settings. The bias is a power of two scale on the allowed
+    // error, positive values select coarser LODs.
+    float lodBias;
+    float lodPixelError;
+    float lodHysteresis;
+
+    // Software occlusion settings. Visible static submeshes larger than 
+    // occluderScreenSize (fraction of the screen height) are occluders.
+    bool occlusionCulling;
+    float occluderScreenSize;
+    uint maxOccluders;
+
     GlobalRendererData()
       : vertexCache(0u, BufferType::Static)
       , indexCache(0u, BufferType::Static)
+      , meshletCache(0u, BufferType::Static)
       , transferBuffer(0u, BufferType::Static)
       , blankVAO()
       , gamma(2.2f)
@@ -56,6 +70,12 @@ namespace Strontium::Renderer3D
       , time(0u)
       , cameraBuffer(3 * sizeof(glm::mat4) + 2 * sizeof(glm::vec4), BufferType::Dynamic)
       , temporalBuffer(4 * sizeof(glm::mat4) + sizeof(glm::vec4), BufferType::Dynamic)
+      , lodBias(0.0f)
+      , lodPixelError(1.0f)
+      , lodHysteresis(0.25f)
+      , occlusionCulling(true)
+      , occluderScreenSize(0.1f)
+      , maxOccluders(32u)
     { }
   };
 
@@ -69,6 +89,10 @@ namespace Strontium::Renderer3D
   // Add a mesh/model to the vertex and index cache.
   void addModelToCache(Model &model);
   void addMeshToCache(Mesh& mesh);
+  void addMeshletsToCache(Mesh& mesh);
+
+  // Select the LOD of a mesh using its projected size on the screen.
+  uint selectMeshLOD(const Mesh &mesh, const glm::mat4 &transform, uint previousLOD = 0u);
 
   // Generic begin and end for the renderer.
   void begin(uint width, uint height, const Camera &sceneCamera, float dt);
@@ -70,6 +70,7 @@ namespace Strontium
     void clear(const bool &clearColour = true, const bool &clearDepth = true,
                const bool &clearStencil = true);
     void setViewport(const glm::ivec2 topRight, const glm::ivec2 bottomLeft = glm::ivec2(0));
+    void setViewportIndexed(uint index, const glm::ivec2 topRight, const glm::ivec2 bottomLeft = glm::ivec2(0));
 
     void drawElements(PrimativeType primative, uint count, const void* indices = nullptr);
     void drawArrays(PrimativeType primative, uint start, uint count);
@@ -37,6 +37,8 @@ namespace Strontium
   enum class MemoryBarrierType
   {
     ShaderImageAccess = 0x00000020, // GL_SHADER_IMAGE_ACCESS_BARRIER_BIT
+    Command = 0x00000040, // GL_COMMAND_BARRIER_BIT
+    BufferUpdate = 0x00000200, // GL_BUFFER_UPDATE_BARRIER_BIT
     ShaderStorageBufferWrites = 0x00002000 // GL_SHADER_STORAGE_BARRIER_BIT
   };
 
@@ -69,6 +71,8 @@ namespace Strontium
 
     void launchCompute(uint globalX, uint globalY, uint globalZ);
 
+    uint getID() const { return this->progID; }
+
     // Setters for shader uniforms.
     void addUniformMatrix(const char* uniformName, const glm::mat4 &matrix,
                           bool transpose);
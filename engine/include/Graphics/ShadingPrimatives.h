@@ -1,5 +1,8 @@
 #pragma once
 
+// Instance flags.
+#define INSTANCE_FLAG_SELECTED 0x1u
+
 // A series of packed primatives for shading.
 namespace Strontium
 {
@@ -27,11 +30,52 @@ namespace Strontium
     { }
   };
 
+  // Per-instance data shared by the passes which draw meshes. Only the
+  // affine part of the model matrix is stored, as its first three rows. The
+  // IDs are the entity ID + 1 (x), zero if there is none, the material ID (y)
+  // and the instance flags (z). W is unused.
+  struct InstanceData
+  {
+    glm::vec4 transformRows[3];
+    glm::uvec4 ids;
+
+    InstanceData()
+      : transformRows{ glm::vec4(1.0f, 0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 1.0f, 0.0f, 0.0f),
+                       glm::vec4(0.0f, 0.0f, 1.0f, 0.0f) }
+      , ids(0u)
+    { }
+
+    InstanceData(const glm::mat4 &transform, const glm::uvec4 &ids = glm::uvec4(0u))
+      : ids(ids)
+    {
+      this->setTransform(transform);
+    }
+
+    void setTransform(const glm::mat4 &transform)
+    {
+      for (uint i = 0; i < 3; i++)
+        this->transformRows[i] = glm::vec4(transform[0][i], transform[1][i], transform[2][i], transform[3][i]);
+    }
+
+    glm::mat4 getTransform() const
+    {
+      return glm::transpose(glm::mat4(this->transformRows[0], this->transformRows[1], this->transformRows[2],
+                                      glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+    }
+
+    glm::vec3 getPosition() const
+    {
+      return glm::vec3(this->transformRows[0].w, this->transformRows[1].w, this->transformRows[2].w);
+    }
+  };
+
   // Material block data.
   struct MaterialBlockData
   {
     glm::vec4 mRAE; // Metallic (r), roughness (g), AO (b) and emission (a);
     glm::vec4 albedoReflectance; // Albedo (r, g, b) and reflectance (a);  
+    glm::vec4 textureLayers0; // Texture page layers of the albedo (x), normal (y), roughness (z) and metallic (w) maps.
+    glm::vec4 textureLayers1; // Texture page layers of the AO (x), specular F0 (y) and emission (z) maps. W is unused.
   };
 
   struct Camera
@@ -0,0 +1,95 @@
+#pragma once
+
+// Macro include file.
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+#include "Core/Math.h"
+
+#define OCCLUSION_TILE_SIZE 8
+
+namespace Strontium
+{
+  struct PackedVertex;
+
+  struct OcclusionStatistics
+  {
+    uint numOccluders;
+    uint numOccluderTriangles;
+    uint numTested;
+    uint numOccluded;
+    float rasterTime;
+
+    OcclusionStatistics()
+      : numOccluders(0u)
+      , numOccluderTriangles(0u)
+      , numTested(0u)
+      , numOccluded(0u)
+      , rasterTime(0.0f)
+    { }
+  };
+
+  // A CPU occlusion buffer. Occluders are rasterized into a small depth buffer
+  // in horizontal bands on the job system, then world space AABBs are tested
+  // against the per-tile farthest depths and refined per pixel. Doesn't touch
+  // the GPU, so it can run headless.
+  class SoftwareOcclusion
+  {
+  public:
+    // The width is rounded up to a multiple of the tile size.
+    SoftwareOcclusion(uint width = 256u, uint height = 128u);
+    ~SoftwareOcclusion() = default;
+
+    void resize(uint width, uint height);
+
+    // Clear the buffer and set the camera for the frame.
+    void begin(const glm::mat4 &view, const glm::mat4 &projection);
+
+    // Queue an occluder, transforming the triangles into screen space.
+    // Triangles crossing the near plane are dropped.
+    void addOccluder(const std::vector<PackedVertex> &vertices, const std::vector<uint> &indices,
+                     const glm::mat4 &transform);
+
+    // Rasterize all the queued occluders.
+    void rasterize();
+
+    // Returns false if a world space AABB is fully hidden behind the occluders.
+    bool testAABB(const glm::vec3 &min, const glm::vec3 &max);
+
+    // Approximate size of a world space sphere on the screen, as a fraction
+    // of the screen height. Used to pick occluders.
+    float screenSize(const glm::vec3 &center, float radius) const;
+
+    uint getWidth() const { return this->width; }
+    uint getHeight() const { return this->height; }
+    const std::vector<float>& getDepthBuffer() const { return this->depthBuffer; }
+    const OcclusionStatistics& getStatistics() const { return this->stats; }
+  private:
+    // Screen space triangle. Positions in pixels, depth in [0, 1].
+    struct OccluderTriangle
+    {
+      glm::vec3 v0;
+      glm::vec3 v1;
+      glm::vec3 v2;
+    };
+
+    void rasterizeBand(uint startRow, uint endRow);
+    void rasterizeTriangle(const OccluderTriangle &triangle, uint startRow, uint endRow);
+
+    uint width;
+    uint height;
+    uint numTilesX;
+    uint numTilesY;
+
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+
+    std::vector<float> depthBuffer; // Nearest occluder depth for each pixel.
+    std::vector<float> tileMaxDepth; // Farthest depth in each tile.
+    std::vector<OccluderTriangle> triangles;
+
+    OcclusionStatistics stats;
+  };
+}
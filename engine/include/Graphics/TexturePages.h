@@ -0,0 +1,78 @@
+#pragma once
+
+// Macro include file.
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+#include "Graphics/Textures.h"
+#include "Assets/Assets.h"
+
+#define MAX_TEXTURE_PAGES 255
+#define MAX_TEXTURE_PAGE_LAYERS 256
+
+namespace Strontium
+{
+  // The page and layer a texture was copied into.
+  struct TexturePageLocation
+  {
+    uint page;
+    uint layer;
+
+    TexturePageLocation(uint page = 0u, uint layer = 0u)
+      : page(page)
+      , layer(layer)
+    { }
+  };
+
+  // Packs 2D textures which share a size, format, sampling parameters and
+  // number of mips into the layers of texture array pages. Textures are
+  // copied on the GPU the first time they're requested and again if their
+  // revision changes. Materials with all of their textures paged can then
+  // be drawn together, since only the pages need to be bound. Textures are
+  // tracked by asset handle, their layers are freed once the asset unloads.
+  class TexturePageCache
+  {
+  public:
+    TexturePageCache();
+    ~TexturePageCache() = default;
+
+    // Copy a texture into a page if it isn't already there. Returns false
+    // if the texture can't be paged.
+    bool makeResident(const Asset::Handle &handle, Texture2D* texture, TexturePageLocation &outLocation);
+
+    // Free the layers of textures which are no longer in the asset cache.
+    void releaseUnloaded();
+
+    Texture2DArray* getPage(uint page) { return this->pages[page].array.get(); }
+
+    // For profiling.
+    uint getNumPages() const { return this->pages.size(); }
+    uint getNumResident() const { return this->residentTextures.size(); }
+  private:
+    struct TexturePage
+    {
+      uint width;
+      uint height;
+      uint numMips;
+      Texture2DParams params;
+
+      Unique<Texture2DArray> array;
+      uint numLayers;
+      std::vector<uint> freeLayers;
+    };
+
+    struct ResidentTexture
+    {
+      uint revision;
+      TexturePageLocation location;
+    };
+
+    // Find or create a page with space for the texture and reserve a layer.
+    bool allocateLayer(Texture2D* texture, TexturePageLocation &outLocation);
+    void growPage(TexturePage &page);
+
+    std::vector<TexturePage> pages;
+    robin_hood::unordered_flat_map<Asset::Handle, ResidentTexture> residentTextures;
+  };
+}
@@ -50,7 +50,11 @@ namespace Strontium
     R32i = 0x8235, // GL_R32I
     RG32i = 0x823B, // GL_RG32I
     RGB32i = 0x8D83, // GL_RGB32I
-    RGBA32i = 0x8D82 // GL_RGBA32I
+    RGBA32i = 0x8D82, // GL_RGBA32I
+
+    // Unsigned int components.
+    R32ui = 0x8236, // GL_R32UI
+    RG32ui = 0x823C // GL_RG32UI
   };
   enum class TextureFormats
   {
@@ -70,6 +74,7 @@ namespace Strontium
     Bytes = 0x1401, // GL_UNSIGNED_BYTE
     Floats = 0x1406, // GL_FLOAT
     Integer = 0x1404, // GL_INT
+    UInt = 0x1405, // GL_UNSIGNED_INT
     UInt24UInt8 = 0x84FA // GL_UNSIGNED_INT_24_8
   };
   enum class TextureWrapParams
@@ -326,10 +331,21 @@ namespace Strontium
 
     int getWidth() { return this->width; }
     int getHeight() { return this->height; }
+    uint getNumMips() { return this->numMips; }
+    Texture2DParams& getParams() { return this->params; }
+
+    // Changes whenever the texture data or parameters change. Revisions are
+    // unique across all textures.
+    uint getRevision() { return this->revision; }
+
+    // Changes whenever any texture is created, changed or destroyed.
+    static uint getLatestRevision();
 
     uint getID() { return this->textureID; }
   private:
     uint textureID;
+    uint revision;
+    uint numMips;
 
     int width;
     int height;
@@ -353,6 +369,12 @@ namespace Strontium
 
     // Init the texture using given data and stored params.
     void initNullTexture();
+    void initNullTexture(uint numMips);
+
+    // Copy the mips of a 2D texture into a layer, or the first layers of
+    // another array. The formats and sizes must match.
+    void copyLayer(Texture2D &source, uint layer, uint numMips);
+    void copyLayers(Texture2DArray &source, uint numLayers, uint numMips);
 
     // Set the parameters after generating the texture.
     void setSize(uint width, uint height, uint numLayers);
@@ -0,0 +1,127 @@
+#pragma once
+
+// Macro include file.
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+#include "Graphics/Animations.h"
+
+// Entity component system includes.
+#include "entt.hpp"
+
+namespace Strontium
+{
+  // A clip sampled at a quantized time.
+  struct AnimationPoseKey
+  {
+    const Animation* animation;
+    int sample;
+
+    bool operator==(const AnimationPoseKey &other) const
+    {
+      return this->animation == other.animation && this->sample == other.sample;
+    }
+  };
+
+  struct AnimationPoseKeyHash
+  {
+    std::size_t operator()(const AnimationPoseKey &key) const
+    {
+      return robin_hood::hash_int(reinterpret_cast<std::uintptr_t>(key.animation)
+                                  ^ (static_cast<uint64_t>(static_cast<uint>(key.sample)) << 32u));
+    }
+  };
+
+  // A skinned pose to evaluate and where it goes in the bone palette. The
+  // pose is sampled with the cursor of the first animator which uses it.
+  struct AnimationPose
+  {
+    Animation* animation;
+    Animator* animator;
+    float aniTime;
+    uint paletteOffset;
+
+    AnimationPose(Animation* animation, Animator* animator, float aniTime, uint paletteOffset)
+      : animation(animation)
+      , animator(animator)
+      , aniTime(aniTime)
+      , paletteOffset(paletteOffset)
+    { }
+  };
+
+  // Updates the animators of a scene in a batch. Animators playing the same
+  // clip at the same quantized time share one evaluated pose, the unique
+  // poses are evaluated in parallel on the job system and written into one
+  // contiguous bone palette.
+  //
+  // Updates are throttled using the visibility the renderer recorded on the
+  // animators last frame. Animators which weren't visible only advance their
+  // time, and small ones are evaluated every few frames and blend between
+  // the evaluated poses in the frames in between.
+  class AnimationUpdater
+  {
+  public:
+    AnimationUpdater();
+    ~AnimationUpdater() = default;
+
+    // Advance every animator and evaluate the poses which changed. The
+    // palette stays valid until the next update.
+    void update(entt::registry &registry, float dt);
+
+    // Drop the poses. Animators pointing into the palette keep a copy.
+    void clear(entt::registry &registry);
+
+    // Poses are shared between animators whose times fall in the same
+    // sample, at the given samples per second.
+    void setPoseSharing(bool enabled) { this->poseSharing = enabled; }
+    void setPoseSampleRate(float samplesPerSecond) { this->poseSampleRate = samplesPerSecond; }
+    bool getPoseSharing() const { return this->poseSharing; }
+    float getPoseSampleRate() const { return this->poseSampleRate; }
+
+    // Animators taller than the full rate height in pixels are evaluated
+    // every frame, ones taller than the half rate height every second frame
+    // and smaller ones every fourth frame.
+    void setThrottling(bool enabled) { this->throttling = enabled; }
+    void setThrottleHeights(float fullRateHeight, float halfRateHeight);
+    bool getThrottling() const { return this->throttling; }
+    float getFullRateHeight() const { return this->fullRateHeight; }
+    float getHalfRateHeight() const { return this->halfRateHeight; }
+
+    const std::vector<glm::mat4>& getBonePalette() const { return this->bonePalette; }
+
+    // For profiling.
+    uint getNumAnimators() const { return this->numAnimators; }
+    uint getNumPoses() const { return this->numPoses; }
+    uint getNumSkipped() const { return this->numSkipped; }
+    uint getNumThrottled() const { return this->numThrottled; }
+    float getUpdateTime() const { return this->updateTime; }
+  private:
+    uint getUpdateInterval(float screenHeight) const;
+
+    std::vector<glm::mat4> bonePalette;
+
+    robin_hood::unordered_flat_map<AnimationPoseKey, uint, AnimationPoseKeyHash> poseMap;
+    std::vector<AnimationPose> poses;
+    std::vector<std::pair<Animator*, uint>> skinnedAnimators;
+    std::vector<Animator*> unskinnedAnimators;
+
+    // Throttled animators and the length of the blend they start this frame,
+    // zero if they keep blending.
+    std::vector<std::pair<Animator*, uint>> throttledAnimators;
+    uint throttleStagger;
+
+    bool poseSharing;
+    float poseSampleRate;
+
+    bool throttling;
+    float fullRateHeight;
+    float halfRateHeight;
+
+    uint numAnimators;
+    uint numPoses;
+    uint numSkipped;
+    uint numThrottled;
+    float updateTime;
+  };
+}
@@ -140,6 +140,9 @@ namespace Strontium
     Animator animator;
     std::string animationHandle;
 
+    // The LOD selected for each submesh last frame.
+    std::vector<uint> selectedLODs;
+
     RenderableComponent(const RenderableComponent&) = default;
 
     RenderableComponent()
@@ -5,7 +5,12 @@
 
 // Project includes.
 #include "Core/ApplicationBase.h"
+#include "Core/DataStructures/DynamicAABBTree.h"
 #include "Graphics/ShadingPrimatives.h"
+#include "Graphics/SoftwareOcclusion.h"
+#include "Graphics/RenderPasses/RenderPass.h"
+#include "Scenes/TransformHierarchy.h"
+#include "Scenes/AnimationUpdater.h"
 
 // Entity component system includes.
 #include "entt.hpp"
@@ -13,6 +18,34 @@
 namespace Strontium
 {
   class Entity;
+  class Model;
+  struct RenderableComponent;
+  struct GeomSubmissionBuffer;
+  struct ShadowSubmissionBuffer;
+
+  // The world transform, culling proxies and retained geometry proxy of a
+  // renderable. Animated renderables don't get proxies and are always visible.
+  struct RenderableProxies
+  {
+    Model* model;
+    glm::mat4 transform;
+
+    std::vector<int> proxyIDs;
+    std::vector<bool> visibleSubmeshes;
+    bool visible;
+
+    RendererDataHandle geometryHandle;
+
+    uint lastSeenFrame;
+
+    RenderableProxies()
+      : model(nullptr)
+      , transform(1.0f)
+      , visible(true)
+      , geometryHandle(-1)
+      , lastSeenFrame(0u)
+    { }
+  };
 
   class Scene
   {
@@ -48,7 +81,8 @@ namespace Strontium
     void setPrimaryDirectionalEntity(Entity entity);
     void clearPrimaryDirectionalEntity() { this->primaryDirLightID = entt::null; }
 
-    // Hierarchy functions.
+    // Hierarchy functions. These walk the hierarchy every call, the render
+    // and physics passes use the cached transforms instead.
     glm::mat4 computeGlobalTransform(Entity entity);
     glm::quat computeGlobalRotation(Entity entity);
 
@@ -80,7 +114,39 @@ namespace Strontium
 
     // For profiling.
     float getRenderSubmitTime() const { return this->renderSubmitTime; }
+    float getCullingTime() const { return this->cullingTime; }
+    uint getNumCullingProxies() const { return this->cullingTree.numProxies(); }
+    uint getNumVisibleProxies() const { return this->numVisibleProxies; }
+    uint getNumTransforms() const { return this->transforms.size(); }
+    uint getNumTransformsUpdated() const { return this->transforms.getNumUpdated(); }
+    float getTransformUpdateTime() const { return this->transforms.getUpdateTime(); }
+    uint getNumAnimators() const { return this->animations.getNumAnimators(); }
+    uint getNumAnimationPoses() const { return this->animations.getNumPoses(); }
+    uint getNumAnimationsSkipped() const { return this->animations.getNumSkipped(); }
+    uint getNumAnimationsThrottled() const { return this->animations.getNumThrottled(); }
+    float getAnimationUpdateTime() const { return this->animations.getUpdateTime(); }
+    const OcclusionStatistics& getOcclusionStatistics() const { return this->occlusion.getStatistics(); }
   protected:
+    // Keep the culling proxies in sync with the renderables. Proxies are only
+    // moved when the world transform changed.
+    void updateCullingProxies();
+    void destroyCullingProxies(RenderableProxies &proxies);
+
+    // Release the retained geometry proxies of all the renderables.
+    void releaseRenderProxies();
+
+    // Submit the renderables to the geometry and shadow passes. The retained
+    // static renderables are updated on the job system. Returns true if the
+    // selected entity was drawn.
+    bool submitRenderables(Entity selectedEntity, bool drawIDs);
+
+    // Mark the visible renderables and submeshes using the culling tree.
+    void cullRenderables(const Frustum &frustum);
+
+    // Rasterize the largest visible submeshes as occluders and hide the 
+    // submeshes behind them.
+    void cullOccluded(const Camera &camera);
+
     entt::entity primaryCameraID;
     entt::entity primaryDirLightID;
 
@@ -89,6 +155,24 @@ namespace Strontium
 
     float renderSubmitTime;
 
+    TransformHierarchy transforms;
+    AnimationUpdater animations;
+
+    DynamicAABBTree cullingTree;
+    robin_hood::unordered_flat_map<entt::entity, RenderableProxies> cullingProxies;
+    uint cullingFrame;
+    uint numVisibleProxies;
+    float cullingTime;
+
+    // Scratch storage for the parallel traversal and submission.
+    std::vector<glm::mat4> drawableTransforms;
+    std::vector<Model*> drawableModels;
+    std::vector<GeomSubmissionBuffer> submissionBuffers;
+    std::vector<ShadowSubmissionBuffer> shadowSubmissionBuffers;
+    std::vector<std::vector<uint>> animatedDrawables;
+
+    SoftwareOcclusion occlusion;
+
     friend class Entity;
     friend class SceneGraphWindow;
   };
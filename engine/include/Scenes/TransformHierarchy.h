@@ -0,0 +1,79 @@
+#pragma once
+
+// Macro include file.
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+#include "Core/Math.h"
+
+// Entity component system includes.
+#include "entt.hpp"
+
+namespace Strontium
+{
+  // A flattened copy of the scene's transform hierarchy. Entities are stored
+  // depth first so every parent comes before its children and every subtree
+  // is contiguous. Local and world matrices are cached, and only the subtrees
+  // under an edited transform are recomputed.
+  class TransformHierarchy
+  {
+  public:
+    TransformHierarchy();
+    ~TransformHierarchy() = default;
+
+    // Sync with the registry and recompute the dirty world transforms. The
+    // flattened arrays are rebuilt if entities or parents changed. Root
+    // subtrees are updated in parallel on the job system.
+    void update(entt::registry &registry);
+
+    // Recompute the subtree under an entity after its local transform was
+    // changed mid-frame.
+    void refresh(entt::registry &registry, entt::entity entity);
+
+    // Remove all entities.
+    void clear();
+
+    bool contains(entt::entity entity) const { return this->indices.find(entity) != this->indices.end(); }
+
+    // Cached world transforms, valid after update(). Entities which aren't in
+    // the hierarchy get the identity.
+    glm::mat4 getWorldTransform(entt::entity entity) const;
+    glm::quat getWorldRotation(entt::entity entity) const;
+
+    // For profiling.
+    uint size() const { return this->entities.size(); }
+    uint getNumUpdated() const { return this->numUpdated; }
+    float getUpdateTime() const { return this->updateTime; }
+  private:
+    void rebuild(entt::registry &registry);
+
+    // Returns false if the flattened hierarchy no longer matches the registry.
+    bool updateRange(entt::registry &registry, uint start, uint end, bool forceDirty,
+                     uint &outUpdated);
+
+    std::vector<entt::entity> entities;
+    std::vector<int> parents;
+    std::vector<uint> subtreeSizes;
+    std::vector<uint> roots;
+    std::vector<uint8_t> hasTransform;
+    std::vector<uint8_t> dirty;
+
+    // Local transforms from the last update, compared against the components
+    // to find edits.
+    std::vector<glm::vec3> translations;
+    std::vector<glm::vec3> rotations;
+    std::vector<glm::vec3> scales;
+
+    std::vector<glm::mat4> localMatrices;
+    std::vector<glm::mat4> worldMatrices;
+    std::vector<glm::quat> localRotations;
+    std::vector<glm::quat> worldRotations;
+
+    robin_hood::unordered_flat_map<entt::entity, uint> indices;
+    uint numTransforms;
+
+    uint numUpdated;
+    float updateTime;
+  };
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "StrontiumPCH.h"
+
+// Project includes.
+#include "Core/ApplicationBase.h"
+
+namespace Strontium
+{
+  class Animation;
+
+  struct BenchmarkResult
+  {
+    std::string name;
+    float msPerIteration;
+    uint result; // Used to check the benchmarked variants agree.
+
+    BenchmarkResult(const std::string &name, float msPerIteration, uint result)
+      : name(name)
+      , msPerIteration(msPerIteration)
+      , result(result)
+    { }
+  };
+
+  namespace Benchmarks
+  {
+    // Time boundingBoxInFrustum against the batched culling kernels on random
+    // transformed boxes. Results are logged and returned.
+    std::vector<BenchmarkResult> frustumCulling(uint numBoxes = 100000u, uint numIterations = 50u);
+
+    // Time the compiled animation tracks against the reference evaluation
+    // for a crowd of characters playing a clip at different times. Each
+    // iteration advances every character by a frame. Also logs the size of
+    // the compressed keys and their largest error against the source.
+    std::vector<BenchmarkResult> animationSampling(Animation &animation, uint numCharacters = 1000u,
+                                                   uint numIterations = 10u);
+  }
+}
@@ -0,0 +1,365 @@
+#include "Core/DataStructures/DynamicAABBTree.h"
+
+namespace Strontium
+{
+  // Surface area heuristic, half the surface area of a box.
+  static float
+  boxCost(const glm::vec3 &min, const glm::vec3 &max)
+  {
+    const glm::vec3 d = max - min;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+  }
+
+  DynamicAABBTree::DynamicAABBTree(float margin)
+    : root(NULL_TREE_NODE)
+    , freeList(NULL_TREE_NODE)
+    , proxyCount(0u)
+    , margin(margin)
+  { }
+
+  int
+  DynamicAABBTree::createProxy(const glm::vec3 &min, const glm::vec3 &max, ulong userData)
+  {
+    int proxyID = this->allocateNode();
+
+    auto& node = this->nodes[proxyID];
+    node.min = min - glm::vec3(this->margin);
+    node.max = max + glm::vec3(this->margin);
+    node.userData = userData;
+    node.height = 0;
+
+    this->insertLeaf(proxyID);
+    this->proxyCount++;
+
+    return proxyID;
+  }
+
+  void
+  DynamicAABBTree::destroyProxy(int proxyID)
+  {
+    assert(("Invalid proxy.", proxyID >= 0 && proxyID < this->nodes.size() && this->nodes[proxyID].isLeaf()));
+
+    this->removeLeaf(proxyID);
+    this->freeNode(proxyID);
+    this->proxyCount--;
+  }
+
+  bool
+  DynamicAABBTree::moveProxy(int proxyID, const glm::vec3 &min, const glm::vec3 &max)
+  {
+    assert(("Invalid proxy.", proxyID >= 0 && proxyID < this->nodes.size() && this->nodes[proxyID].isLeaf()));
+
+    auto& node = this->nodes[proxyID];
+
+    // Still inside the fattened box.
+    if (glm::all(glm::lessThanEqual(node.min, min)) && glm::all(glm::greaterThanEqual(node.max, max)))
+      return false;
+
+    this->removeLeaf(proxyID);
+
+    this->nodes[proxyID].min = min - glm::vec3(this->margin);
+    this->nodes[proxyID].max = max + glm::vec3(this->margin);
+
+    this->insertLeaf(proxyID);
+
+    return true;
+  }
+
+  void
+  DynamicAABBTree::clear()
+  {
+    this->nodes.clear();
+    this->root = NULL_TREE_NODE;
+    this->freeList = NULL_TREE_NODE;
+    this->proxyCount = 0u;
+  }
+
+  int
+  DynamicAABBTree::allocateNode()
+  {
+    if (this->freeList == NULL_TREE_NODE)
+    {
+      this->nodes.emplace_back();
+      this->nodes.back().height = 0;
+      return static_cast<int>(this->nodes.size() - 1);
+    }
+
+    int nodeID = this->freeList;
+    this->freeList = this->nodes[nodeID].parentOrNext;
+    this->nodes[nodeID] = TreeNode();
+    this->nodes[nodeID].height = 0;
+
+    return nodeID;
+  }
+
+  void
+  DynamicAABBTree::freeNode(int nodeID)
+  {
+    this->nodes[nodeID].parentOrNext = this->freeList;
+    this->nodes[nodeID].height = -1;
+    this->freeList = nodeID;
+  }
+
+  // Insert a leaf next to the sibling which increases the surface area of the
+  // tree the least.
+  void
+  DynamicAABBTree::insertLeaf(int leafID)
+  {
+    if (this->root == NULL_TREE_NODE)
+    {
+      this->root = leafID;
+      this->nodes[leafID].parentOrNext = NULL_TREE_NODE;
+      return;
+    }
+
+    const glm::vec3 leafMin = this->nodes[leafID].min;
+    const glm::vec3 leafMax = this->nodes[leafID].max;
+
+    // Find the best sibling.
+    int index = this->root;
+    while (!this->nodes[index].isLeaf())
+    {
+      const auto& node = this->nodes[index];
+      const int child1 = node.child1;
+      const int child2 = node.child2;
+
+      const float area = boxCost(node.min, node.max);
+      const float combinedArea = boxCost(glm::min(node.min, leafMin), glm::max(node.max, leafMax));
+
+      // Cost of creating a new parent for this node and the leaf.
+      const float cost = 2.0f * combinedArea;
+
+      // Minimum cost of pushing the leaf further down the tree.
+      const float inheritanceCost = 2.0f * (combinedArea - area);
+
+      auto descendCost = [&](int childID)
+      {
+        const auto& child = this->nodes[childID];
+        const float newArea = boxCost(glm::min(child.min, leafMin), glm::max(child.max, leafMax));
+        if (child.isLeaf())
+          return newArea + inheritanceCost;
+
+        return (newArea - boxCost(child.min, child.max)) + inheritanceCost;
+      };
+
+      const float cost1 = descendCost(child1);
+      const float cost2 = descendCost(child2);
+
+      if (cost < cost1 && cost < cost2)
+        break;
+
+      index = cost1 < cost2 ? child1 : child2;
+    }
+
+    const int sibling = index;
+
+    // Create a new parent.
+    const int oldParent = this->nodes[sibling].parentOrNext;
+    const int newParent = this->allocateNode();
+    this->nodes[newParent].parentOrNext = oldParent;
+    this->nodes[newParent].min = glm::min(this->nodes[sibling].min, leafMin);
+    this->nodes[newParent].max = glm::max(this->nodes[sibling].max, leafMax);
+    this->nodes[newParent].height = this->nodes[sibling].height + 1;
+    this->nodes[newParent].child1 = sibling;
+    this->nodes[newParent].child2 = leafID;
+    this->nodes[sibling].parentOrNext = newParent;
+    this->nodes[leafID].parentOrNext = newParent;
+
+    if (oldParent != NULL_TREE_NODE)
+    {
+      if (this->nodes[oldParent].child1 == sibling)
+        this->nodes[oldParent].child1 = newParent;
+      else
+        this->nodes[oldParent].child2 = newParent;
+    }
+    else
+      this->root = newParent;
+
+    // Walk back up the tree fixing heights and boxes.
+    index = this->nodes[leafID].parentOrNext;
+    while (index != NULL_TREE_NODE)
+    {
+      index = this->balance(index);
+
+      auto& node = this->nodes[index];
+      const auto& child1 = this->nodes[node.child1];
+      const auto& child2 = this->nodes[node.child2];
+      node.height = 1 + glm::max(child1.height, child2.height);
+      node.min = glm::min(child1.min, child2.min);
+      node.max = glm::max(child1.max, child2.max);
+
+      index = node.parentOrNext;
+    }
+  }
+
+  void
+  DynamicAABBTree::removeLeaf(int leafID)
+  {
+    if (leafID == this->root)
+    {
+      this->root = NULL_TREE_NODE;
+      return;
+    }
+
+    const int parent = this->nodes[leafID].parentOrNext;
+    const int grandParent = this->nodes[parent].parentOrNext;
+    const int sibling = this->nodes[parent].child1 == leafID ? this->nodes[parent].child2
+                                                              : this->nodes[parent].child1;
+
+    if (grandParent != NULL_TREE_NODE)
+    {
+      // Destroy the parent and connect the sibling to the grand parent.
+      if (this->nodes[grandParent].child1 == parent)
+        this->nodes[grandParent].child1 = sibling;
+      else
+        this->nodes[grandParent].child2 = sibling;
+      this->nodes[sibling].parentOrNext = grandParent;
+      this->freeNode(parent);
+
+      int index = grandParent;
+      while (index != NULL_TREE_NODE)
+      {
+        index = this->balance(index);
+
+        auto& node = this->nodes[index];
+        const auto& child1 = this->nodes[node.child1];
+        const auto& child2 = this->nodes[node.child2];
+        node.min = glm::min(child1.min, child2.min);
+        node.max = glm::max(child1.max, child2.max);
+        node.height = 1 + glm::max(child1.height, child2.height);
+
+        index = node.parentOrNext;
+      }
+    }
+    else
+    {
+      this->root = sibling;
+      this->nodes[sibling].parentOrNext = NULL_TREE_NODE;
+      this->freeNode(parent);
+    }
+  }
+
+  // Rotate the subtree rooted at A if it is imbalanced. Returns the new root
+  // of the subtree.
+  int
+  DynamicAABBTree::balance(int iA)
+  {
+    auto& A = this->nodes[iA];
+    if (A.isLeaf() || A.height < 2)
+      return iA;
+
+    const int iB = A.child1;
+    const int iC = A.child2;
+    const int balanceFactor = this->nodes[iC].height - this->nodes[iB].height;
+
+    // Rotate C up.
+    if (balanceFactor > 1)
+    {
+      auto& B = this->nodes[iB];
+      auto& C = this->nodes[iC];
+      const int iF = C.child1;
+      const int iG = C.child2;
+      auto& F = this->nodes[iF];
+      auto& G = this->nodes[iG];
+
+      // Swap A and C.
+      C.child1 = iA;
+      C.parentOrNext = A.parentOrNext;
+      A.parentOrNext = iC;
+
+      if (C.parentOrNext != NULL_TREE_NODE)
+      {
+        if (this->nodes[C.parentOrNext].child1 == iA)
+          this->nodes[C.parentOrNext].child1 = iC;
+        else
+          this->nodes[C.parentOrNext].child2 = iC;
+      }
+      else
+        this->root = iC;
+
+      // Rotate.
+      if (F.height > G.height)
+      {
+        C.child2 = iF;
+        A.child2 = iG;
+        G.parentOrNext = iA;
+        A.min = glm::min(B.min, G.min);
+        A.max = glm::max(B.max, G.max);
+        C.min = glm::min(A.min, F.min);
+        C.max = glm::max(A.max, F.max);
+        A.height = 1 + glm::max(B.height, G.height);
+        C.height = 1 + glm::max(A.height, F.height);
+      }
+      else
+      {
+        C.child2 = iG;
+        A.child2 = iF;
+        F.parentOrNext = iA;
+        A.min = glm::min(B.min, F.min);
+        A.max = glm::max(B.max, F.max);
+        C.min = glm::min(A.min, G.min);
+        C.max = glm::max(A.max, G.max);
+        A.height = 1 + glm::max(B.height, F.height);
+        C.height = 1 + glm::max(A.height, G.height);
+      }
+
+      return iC;
+    }
+
+    // Rotate B up.
+    if (balanceFactor < -1)
+    {
+      auto& B = this->nodes[iB];
+      auto& C = this->nodes[iC];
+      const int iD = B.child1;
+      const int iE = B.child2;
+      auto& D = this->nodes[iD];
+      auto& E = this->nodes[iE];
+
+      // Swap A and B.
+      B.child1 = iA;
+      B.parentOrNext = A.parentOrNext;
+      A.parentOrNext = iB;
+
+      if (B.parentOrNext != NULL_TREE_NODE)
+      {
+        if (this->nodes[B.parentOrNext].child1 == iA)
+          this->nodes[B.parentOrNext].child1 = iB;
+        else
+          this->nodes[B.parentOrNext].child2 = iB;
+      }
+      else
+        this->root = iB;
+
+      // Rotate.
+      if (D.height > E.height)
+      {
+        B.child2 = iD;
+        A.child1 = iE;
+        E.parentOrNext = iA;
+        A.min = glm::min(C.min, E.min);
+        A.max = glm::max(C.max, E.max);
+        B.min = glm::min(A.min, D.min);
+        B.max = glm::max(A.max, D.max);
+        A.height = 1 + glm::max(C.height, E.height);
+        B.height = 1 + glm::max(A.height, D.height);
+      }
+      else
+      {
+        B.child2 = iE;
+        A.child1 = iD;
+        D.parentOrNext = iA;
+        A.min = glm::min(C.min, D.min);
+        A.max = glm::max(C.max, D.max);
+        B.min = glm::min(A.min, E.min);
+        B.max = glm::max(A.max, E.max);
+        A.height = 1 + glm::max(C.height, D.height);
+        B.height = 1 + glm::max(A.height, E.height);
+      }
+
+      return iB;
+    }
+
+    return iA;
+  }
+}
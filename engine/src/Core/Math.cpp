@@ -1,5 +1,10 @@
 #include "Core/Math.h"
 
+// SIMD includes.
+#if defined(STRONTIUM_SSE) || defined(STRONTIUM_AVX2)
+  #include <immintrin.h>
+#endif
+
 namespace Strontium
 {
   BoundingBox
@@ -271,4 +276,254 @@ namespace Strontium
 
     return inFrustum;
   }
+
+  //----------------------------------------------------------------------------
+  // Batched culling.
+  //----------------------------------------------------------------------------
+  void
+  AABBBatch::push(const BoundingBox &box)
+  {
+    this->centerX.push_back(box.center.x);
+    this->centerY.push_back(box.center.y);
+    this->centerZ.push_back(box.center.z);
+    this->extentX.push_back(box.extents.x);
+    this->extentY.push_back(box.extents.y);
+    this->extentZ.push_back(box.extents.z);
+  }
+
+  void
+  AABBBatch::push(const glm::vec3 &min, const glm::vec3 &max)
+  {
+    this->push(buildBoundingBox(min, max));
+  }
+
+  void
+  AABBBatch::push(const glm::vec3 &min, const glm::vec3 &max, const glm::mat4 &transform)
+  {
+    this->push(buildBoundingBox(min, max, transform));
+  }
+
+  void
+  AABBBatch::reserve(uint numBoxes)
+  {
+    this->centerX.reserve(numBoxes);
+    this->centerY.reserve(numBoxes);
+    this->centerZ.reserve(numBoxes);
+    this->extentX.reserve(numBoxes);
+    this->extentY.reserve(numBoxes);
+    this->extentZ.reserve(numBoxes);
+  }
+
+  void
+  AABBBatch::clear()
+  {
+    this->centerX.clear();
+    this->centerY.clear();
+    this->centerZ.clear();
+    this->extentX.clear();
+    this->extentY.clear();
+    this->extentZ.clear();
+  }
+
+  // Tests the boxes in [start, end) one at a time.
+  static uint
+  batchCullRange(const Frustum &frustum, const AABBBatch &boxes, uint start, uint end,
+                 std::vector<uint> &outVisibility)
+  {
+    uint numVisible = 0u;
+    for (uint i = start; i < end; i++)
+    {
+      bool visible = true;
+      for (uint j = 0; j < 6 && visible; j++)
+      {
+        const Plane &plane = frustum.sides[j];
+        const float distance = plane.normal.x * boxes.centerX[i] + plane.normal.y * boxes.centerY[i]
+                             + plane.normal.z * boxes.centerZ[i] - plane.d;
+        const float radius = std::abs(plane.normal.x) * boxes.extentX[i] + std::abs(plane.normal.y) * boxes.extentY[i]
+                           + std::abs(plane.normal.z) * boxes.extentZ[i];
+        visible = distance + radius >= 0.0f;
+      }
+
+      if (visible)
+      {
+        outVisibility[i / 32u] |= 1u << (i % 32u);
+        numVisible++;
+      }
+    }
+
+    return numVisible;
+  }
+
+  uint
+  batchBoundingBoxInFrustumScalar(const Frustum &frustum, const AABBBatch &boxes,
+                                  std::vector<uint> &outVisibility)
+  {
+    outVisibility.assign((boxes.size() + 31u) / 32u, 0u);
+    return batchCullRange(frustum, boxes, 0u, boxes.size(), outVisibility);
+  }
+
+  uint
+  batchBoundingBoxInFrustumSSE(const Frustum &frustum, const AABBBatch &boxes,
+                               std::vector<uint> &outVisibility)
+  {
+#if defined(STRONTIUM_SSE)
+    outVisibility.assign((boxes.size() + 31u) / 32u, 0u);
+
+    // Broadcast the planes once.
+    __m128 nx[6], ny[6], nz[6], ax[6], ay[6], az[6], d[6];
+    for (uint j = 0; j < 6; j++)
+    {
+      const Plane &plane = frustum.sides[j];
+      nx[j] = _mm_set1_ps(plane.normal.x);
+      ny[j] = _mm_set1_ps(plane.normal.y);
+      nz[j] = _mm_set1_ps(plane.normal.z);
+      ax[j] = _mm_set1_ps(std::abs(plane.normal.x));
+      ay[j] = _mm_set1_ps(std::abs(plane.normal.y));
+      az[j] = _mm_set1_ps(std::abs(plane.normal.z));
+      d[j] = _mm_set1_ps(plane.d);
+    }
+    const __m128 zero = _mm_setzero_ps();
+
+    uint numVisible = 0u;
+    const uint numBatched = boxes.size() & ~3u;
+    for (uint i = 0; i < numBatched; i += 4)
+    {
+      const __m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+      const __m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+      const __m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+      const __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+      const __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+      const __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+      __m128 inside = _mm_cmpeq_ps(zero, zero);
+      for (uint j = 0; j < 6; j++)
+      {
+        __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[j], cx), _mm_mul_ps(ny[j], cy)),
+                                     _mm_sub_ps(_mm_mul_ps(nz[j], cz), d[j]));
+        __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[j], ex), _mm_mul_ps(ay[j], ey)),
+                                   _mm_mul_ps(az[j], ez));
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+      }
+
+      const uint mask = static_cast<uint>(_mm_movemask_ps(inside));
+      outVisibility[i / 32u] |= mask << (i % 32u);
+      for (uint bits = mask; bits != 0u; bits &= bits - 1u)
+        numVisible++;
+    }
+
+    return numVisible + batchCullRange(frustum, boxes, numBatched, boxes.size(), outVisibility);
+#else
+    return batchBoundingBoxInFrustumScalar(frustum, boxes, outVisibility);
+#endif
+  }
+
+  uint
+  batchBoundingBoxInFrustumAVX2(const Frustum &frustum, const AABBBatch &boxes,
+                                std::vector<uint> &outVisibility)
+  {
+#if defined(STRONTIUM_AVX2)
+    outVisibility.assign((boxes.size() + 31u) / 32u, 0u);
+
+    // Broadcast the planes once.
+    __m256 nx[6], ny[6], nz[6], ax[6], ay[6], az[6], d[6];
+    for (uint j = 0; j < 6; j++)
+    {
+      const Plane &plane = frustum.sides[j];
+      nx[j] = _mm256_set1_ps(plane.normal.x);
+      ny[j] = _mm256_set1_ps(plane.normal.y);
+      nz[j] = _mm256_set1_ps(plane.normal.z);
+      ax[j] = _mm256_set1_ps(std::abs(plane.normal.x));
+      ay[j] = _mm256_set1_ps(std::abs(plane.normal.y));
+      az[j] = _mm256_set1_ps(std::abs(plane.normal.z));
+      d[j] = _mm256_set1_ps(plane.d);
+    }
+    const __m256 zero = _mm256_setzero_ps();
+
+    uint numVisible = 0u;
+    const uint numBatched = boxes.size() & ~7u;
+    for (uint i = 0; i < numBatched; i += 8)
+    {
+      const __m256 cx = _mm256_loadu_ps(&boxes.centerX[i]);
+      const __m256 cy = _mm256_loadu_ps(&boxes.centerY[i]);
+      const __m256 cz = _mm256_loadu_ps(&boxes.centerZ[i]);
+      const __m256 ex = _mm256_loadu_ps(&boxes.extentX[i]);
+      const __m256 ey = _mm256_loadu_ps(&boxes.extentY[i]);
+      const __m256 ez = _mm256_loadu_ps(&boxes.extentZ[i]);
+
+      __m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+      for (uint j = 0; j < 6; j++)
+      {
+        __m256 distance = _mm256_fmadd_ps(nx[j], cx, _mm256_fmadd_ps(ny[j], cy, _mm256_fmsub_ps(nz[j], cz, d[j])));
+        __m256 radius = _mm256_fmadd_ps(ax[j], ex, _mm256_fmadd_ps(ay[j], ey, _mm256_mul_ps(az[j], ez)));
+        inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+      }
+
+      const uint mask = static_cast<uint>(_mm256_movemask_ps(inside));
+      outVisibility[i / 32u] |= mask << (i % 32u);
+      for (uint bits = mask; bits != 0u; bits &= bits - 1u)
+        numVisible++;
+    }
+
+    return numVisible + batchCullRange(frustum, boxes, numBatched, boxes.size(), outVisibility);
+#else
+    return batchBoundingBoxInFrustumSSE(frustum, boxes, outVisibility);
+#endif
+  }
+
+  bool
+  batchCullingSSESupported()
+  {
+#if defined(STRONTIUM_SSE)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  bool
+  batchCullingAVX2Supported()
+  {
+#if defined(STRONTIUM_AVX2)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  uint
+  batchBoundingBoxInFrustum(const Frustum &frustum, const AABBBatch &boxes,
+                            std::vector<uint> &outVisibility)
+  {
+#if defined(STRONTIUM_AVX2)
+    return batchBoundingBoxInFrustumAVX2(frustum, boxes, outVisibility);
+#elif defined(STRONTIUM_SSE)
+    return batchBoundingBoxInFrustumSSE(frustum, boxes, outVisibility);
+#else
+    return batchBoundingBoxInFrustumScalar(frustum, boxes, outVisibility);
+#endif
+  }
+
+  void
+  multiplyMatrices(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &out)
+  {
+#if defined(STRONTIUM_SSE)
+    // Each column of the product is a linear combination of the columns of a.
+    const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+    const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+    const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+    const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+
+    for (uint i = 0; i < 4; i++)
+    {
+      const __m128 column = _mm_loadu_ps(&b[i][0]);
+      __m128 result = _mm_mul_ps(a0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)));
+      result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1))));
+      result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+      result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3))));
+      _mm_storeu_ps(&out[i][0], result);
+    }
+#else
+    out = a * b;
+#endif
+  }
 }
@@ -2,6 +2,8 @@
 
 // Project includes.
 #include "Core/Application.h"
+#include "Core/Logs.h"
+#include "Core/Math.h"
 
 #include "Assets/AssetManager.h"
 #include "Assets/ModelAsset.h"
@@ -16,17 +18,362 @@
 
 namespace Strontium
 {
+  // Find the key before keyTime in a track with at least two keys, starting
+  // from the cursor. Searches from the first key again if time went
+  // backwards, which happens when the clip loops.
+  static uint
+  findKey(const ushort* times, uint numKeys, float keyTime, uint &cursor)
+  {
+    uint key = cursor;
+    if (key >= numKeys - 1u || times[key] > keyTime)
+      key = 0u;
+
+    while (key < numKeys - 2u && keyTime >= times[key + 1u])
+      key++;
+
+    cursor = key;
+    return key;
+  }
+
+  // The interpolation factor between a key and the next one.
+  static float
+  keyFactor(const ushort* times, uint key, float keyTime)
+  {
+    const float dt = static_cast<float>(times[key + 1u]) - static_cast<float>(times[key]);
+    return dt > 0.0f ? glm::clamp((keyTime - times[key]) / dt, 0.0f, 1.0f) : 0.0f;
+  }
+
+  static glm::vec3
+  unpackVec3(const AnimationKeyRange &range, const PackedAnimationKey &key, const PackedAnimationKey* lowKey)
+  {
+    const glm::vec3 value = range.min + range.step * glm::vec3(key.x, key.y, key.z);
+    return lowKey ? value + range.lowStep * glm::vec3(lowKey->x, lowKey->y, lowKey->z) : value;
+  }
+
+  static glm::vec3
+  mixPacked(const PackedAnimationKey &start, const PackedAnimationKey &end, float factor)
+  {
+    return glm::mix(glm::vec3(start.x, start.y, start.z), glm::vec3(end.x, end.y, end.z), factor);
+  }
+
+  // Three components of a unit quaternion which aren't the largest are in
+  // [-1/sqrt(2), 1/sqrt(2)].
+  static constexpr float quatComponentRange = 0.70710678f;
+
+  static PackedAnimationKey
+  packQuat(const glm::quat &rotation)
+  {
+    const glm::quat normalized = glm::normalize(rotation);
+    float values[4] = { normalized.x, normalized.y, normalized.z, normalized.w };
+
+    uint largest = 0u;
+    for (uint i = 1; i < 4; i++)
+    {
+      if (glm::abs(values[i]) > glm::abs(values[largest]))
+        largest = i;
+    }
+
+    // q and -q are the same rotation, keep the dropped component positive.
+    const float sign = values[largest] < 0.0f ? -1.0f : 1.0f;
+
+    ushort packed[3];
+    uint component = 0u;
+    for (uint i = 0; i < 4; i++)
+    {
+      if (i == largest)
+        continue;
+
+      const float normalizedValue = glm::clamp(0.5f * (sign * values[i] / quatComponentRange + 1.0f), 0.0f, 1.0f);
+      packed[component++] = static_cast<ushort>(glm::round(normalizedValue * 32767.0f));
+    }
+
+    PackedAnimationKey key;
+    key.x = packed[0] | static_cast<ushort>((largest & 1u) << 15u);
+    key.y = packed[1] | static_cast<ushort>((largest >> 1u) << 15u);
+    key.z = packed[2];
+    return key;
+  }
+
+  static glm::quat
+  unpackQuat(const PackedAnimationKey &key)
+  {
+    const uint largest = (key.x >> 15u) | ((key.y >> 15u) << 1u);
+    const float scale = 2.0f * quatComponentRange / 32767.0f;
+    const float a = static_cast<float>(key.x & 0x7FFFu) * scale - quatComponentRange;
+    const float b = static_cast<float>(key.y & 0x7FFFu) * scale - quatComponentRange;
+    const float c = static_cast<float>(key.z & 0x7FFFu) * scale - quatComponentRange;
+    const float d = std::sqrt(glm::max(1.0f - a * a - b * b - c * c, 0.0f));
+
+    switch (largest)
+    {
+      case 0: return glm::quat(c, d, a, b);
+      case 1: return glm::quat(c, a, d, b);
+      case 2: return glm::quat(c, a, b, d);
+      default: return glm::quat(d, a, b, c);
+    }
+  }
+
+  // Normalized lerp along the shortest arc. Keys are close enough together
+  // that it's indistinguishable from slerp.
+  static glm::quat
+  nlerpQuat(const glm::quat &a, const glm::quat &b, float factor)
+  {
+    const glm::quat end = glm::dot(a, b) < 0.0f ? -b : b;
+    return glm::normalize(a * (1.0f - factor) + end * factor);
+  }
+
+  static glm::vec3
+  sampleVec3(const AnimationTrack &track, const AnimationKeyRange &range, const std::vector<ushort> &times,
+             const std::vector<PackedAnimationKey> &keys, const std::vector<PackedAnimationKey> &lowKeys,
+             float keyTime, uint &cursor)
+  {
+    const PackedAnimationKey* trackLowKeys = range.lowKeys >= 0 ? lowKeys.data() + range.lowKeys : nullptr;
+    if (track.numKeys == 1u)
+      return unpackVec3(range, keys[track.firstKey], trackLowKeys);
+
+    const ushort* trackTimes = times.data() + track.firstKey;
+    const PackedAnimationKey* trackKeys = keys.data() + track.firstKey;
+    const uint key = findKey(trackTimes, track.numKeys, keyTime, cursor);
+    const float factor = keyFactor(trackTimes, key, keyTime);
+
+    // Dequantizing is linear, so interpolate the packed values and
+    // dequantize once.
+    const glm::vec3 value = range.min + range.step * mixPacked(trackKeys[key], trackKeys[key + 1u], factor);
+    if (!trackLowKeys)
+      return value;
+
+    return value + range.lowStep * mixPacked(trackLowKeys[key], trackLowKeys[key + 1u], factor);
+  }
+
+  static glm::quat
+  sampleQuat(const AnimationTrack &track, const std::vector<ushort> &times,
+             const std::vector<PackedAnimationKey> &keys, float keyTime, uint &cursor)
+  {
+    if (track.numKeys == 1u)
+      return unpackQuat(keys[track.firstKey]);
+
+    const ushort* trackTimes = times.data() + track.firstKey;
+    const PackedAnimationKey* trackKeys = keys.data() + track.firstKey;
+    const uint key = findKey(trackTimes, track.numKeys, keyTime, cursor);
+    return nlerpQuat(unpackQuat(trackKeys[key]), unpackQuat(trackKeys[key + 1u]),
+                     keyFactor(trackTimes, key, keyTime));
+  }
+
+  // Pick the keys of a channel to keep. Keys are dropped while interpolating
+  // the decompressed keys around them stays within maxError of the source,
+  // so the bound covers the quantization error too.
+  template <typename T, typename Interpolate, typename Distance>
+  static std::vector<uint>
+  reduceKeys(const std::vector<float> &times, const std::vector<T> &decompressed, const std::vector<T> &source,
+             float maxError, Interpolate interpolate, Distance distance)
+  {
+    const uint numKeys = times.size();
+    std::vector<uint> kept(1u, 0u);
+
+    // Constant channels only need a single key.
+    bool constant = true;
+    for (uint i = 0; i < numKeys && constant; i++)
+      constant = distance(decompressed[0], source[i]) <= maxError;
+    if (constant)
+      return kept;
+
+    uint start = 0u;
+    for (uint end = 2u; end < numKeys; end++)
+    {
+      const float span = times[end] - times[start];
+      for (uint i = start + 1u; i < end; i++)
+      {
+        const float factor = span > 0.0f ? (times[i] - times[start]) / span : 0.0f;
+        if (distance(interpolate(decompressed[start], decompressed[end], factor), source[i]) > maxError)
+        {
+          kept.push_back(end - 1u);
+          start = end - 1u;
+          break;
+        }
+      }
+    }
+    kept.push_back(numKeys - 1u);
+
+    return kept;
+  }
+
+  // The largest error of the kept keys against the source keys.
+  template <typename T, typename Interpolate, typename Distance>
+  static float
+  measureError(const std::vector<float> &times, const std::vector<T> &decompressed, const std::vector<T> &source,
+               const std::vector<uint> &kept, Interpolate interpolate, Distance distance)
+  {
+    float error = 0.0f;
+    if (kept.size() == 1u)
+    {
+      for (auto& value : source)
+        error = glm::max(error, distance(decompressed[kept[0]], value));
+      return error;
+    }
+
+    for (uint i = 0; i < kept.size() - 1u; i++)
+    {
+      const uint start = kept[i];
+      const uint end = kept[i + 1u];
+      const float span = times[end] - times[start];
+      for (uint j = start; j <= end; j++)
+      {
+        const float factor = span > 0.0f ? (times[j] - times[start]) / span : 0.0f;
+        error = glm::max(error, distance(interpolate(decompressed[start], decompressed[end], factor), source[j]));
+      }
+    }
+
+    return error;
+  }
+
+  static ushort
+  quantizeTime(float time, float timeStep)
+  {
+    return static_cast<ushort>(glm::round(glm::clamp(time / timeStep, 0.0f, 65535.0f)));
+  }
+
+  static PackedAnimationKey
+  packComponents(const glm::dvec3 &components)
+  {
+    PackedAnimationKey key;
+    key.x = static_cast<ushort>(components.x);
+    key.y = static_cast<ushort>(components.y);
+    key.z = static_cast<ushort>(components.z);
+    return key;
+  }
+
+  // Quantize a translation or scale channel over its range, drop the keys
+  // which aren't needed and append the rest to the flat arrays of a clip.
+  // Keys are quantized to 16 bits, unless half a step is over the error
+  // bound. Those tracks are quantized to 32 bits and store the low 16 bits
+  // separately. Returns the largest error of the compressed track.
+  template <typename Distance>
+  static float
+  compressVec3Track(const std::vector<std::pair<float, glm::vec3>> &channel, float timeStep, float maxError,
+                    Distance distance, std::vector<AnimationTrack> &tracks, std::vector<AnimationKeyRange> &ranges,
+                    std::vector<ushort> &times, std::vector<PackedAnimationKey> &keys,
+                    std::vector<PackedAnimationKey> &lowKeys)
+  {
+    glm::vec3 min = channel[0].second;
+    glm::vec3 max = channel[0].second;
+    for (auto& [time, value] : channel)
+    {
+      min = glm::min(min, value);
+      max = glm::max(max, value);
+    }
+
+    const bool wide = distance(glm::vec3(0.0f), 0.5f * (max - min) / 65535.0f) > maxError;
+    const double numSteps = wide ? 4294967295.0 : 65535.0;
+    const glm::dvec3 extent = glm::dvec3(max) - glm::dvec3(min);
+    const glm::dvec3 lowStep = extent / numSteps;
+    const AnimationKeyRange range(min, glm::vec3(wide ? lowStep * 65536.0 : lowStep),
+                                  glm::vec3(wide ? lowStep : glm::dvec3(0.0)),
+                                  wide ? static_cast<int>(lowKeys.size()) : -1);
+
+    std::vector<float> keyTimes;
+    std::vector<glm::vec3> source;
+    std::vector<glm::vec3> decompressed;
+    std::vector<PackedAnimationKey> packed;
+    std::vector<PackedAnimationKey> packedLow;
+    for (auto& [time, value] : channel)
+    {
+      const glm::dvec3 offset = glm::dvec3(value) - glm::dvec3(min);
+      const glm::dvec3 normalized = glm::clamp(offset / glm::max(extent, glm::dvec3(1e-12)), 0.0, 1.0);
+      const glm::dvec3 quantized = glm::round(normalized * numSteps);
+
+      keyTimes.push_back(static_cast<float>(quantizeTime(time, timeStep)) * timeStep);
+      source.push_back(value);
+      if (wide)
+      {
+        const glm::dvec3 high = glm::floor(quantized / 65536.0);
+        packed.push_back(packComponents(high));
+        packedLow.push_back(packComponents(quantized - high * 65536.0));
+        decompressed.push_back(unpackVec3(range, packed.back(), &packedLow.back()));
+      }
+      else
+      {
+        packed.push_back(packComponents(quantized));
+        decompressed.push_back(unpackVec3(range, packed.back(), nullptr));
+      }
+    }
+
+    auto interpolate = [](const glm::vec3 &a, const glm::vec3 &b, float factor) { return glm::mix(a, b, factor); };
+    auto kept = reduceKeys(keyTimes, decompressed, source, maxError, interpolate, distance);
+
+    tracks.emplace_back(times.size(), kept.size());
+    ranges.push_back(range);
+    for (auto key : kept)
+    {
+      times.push_back(quantizeTime(channel[key].first, timeStep));
+      keys.push_back(packed[key]);
+      if (wide)
+        lowKeys.push_back(packedLow[key]);
+    }
+
+    return measureError(keyTimes, decompressed, source, kept, interpolate, distance);
+  }
+
+  // Pack a rotation channel as smallest three quaternions, drop the keys
+  // which aren't needed and append the rest to the flat arrays of a clip.
+  // Returns the largest error of the compressed track.
+  static float
+  compressQuatTrack(const std::vector<std::pair<float, glm::quat>> &channel, float timeStep, float maxError,
+                    std::vector<AnimationTrack> &tracks, std::vector<ushort> &times,
+                    std::vector<PackedAnimationKey> &keys)
+  {
+    std::vector<float> keyTimes;
+    std::vector<glm::quat> source;
+    std::vector<glm::quat> decompressed;
+    std::vector<PackedAnimationKey> packed;
+    for (auto& [time, value] : channel)
+    {
+      const PackedAnimationKey key = packQuat(value);
+
+      keyTimes.push_back(static_cast<float>(quantizeTime(time, timeStep)) * timeStep);
+      source.push_back(glm::normalize(value));
+      decompressed.push_back(unpackQuat(key));
+      packed.push_back(key);
+    }
+
+    // The angle between the two rotations, from the chord between them.
+    // Taking the acos of their dot product loses too much precision.
+    auto distance = [](const glm::quat &a, const glm::quat &b)
+    {
+      const glm::quat difference = glm::dot(a, b) < 0.0f ? a + b : a + (-b);
+      const float chord = std::sqrt(glm::dot(difference, difference));
+      return 4.0f * std::asin(glm::min(0.5f * chord, 1.0f));
+    };
+    auto kept = reduceKeys(keyTimes, decompressed, source, maxError, nlerpQuat, distance);
+
+    tracks.emplace_back(times.size(), kept.size());
+    for (auto key : kept)
+    {
+      times.push_back(quantizeTime(channel[key].first, timeStep));
+      keys.push_back(packed[key]);
+    }
+
+    return measureError(keyTimes, decompressed, source, kept, nlerpQuat, distance);
+  }
+
   //----------------------------------------------------------------------------
   // Animation class.
   //----------------------------------------------------------------------------
-  Animation::Animation(const aiAnimation* animation, Model* parentModel)
+  Animation::Animation(const aiAnimation* animation, Model* parentModel, const std::string &sourcePath,
+                       uint sourceIndex)
     : parentModel(parentModel)
+    , sourcePath(sourcePath)
+    , sourceIndex(sourceIndex)
+    , numChannels(0u)
+    , sourceSize(0u)
   {
     this->loadAnimation(animation);
   }
 
   Animation::Animation(Model* parentModel)
     : parentModel(parentModel)
+    , sourceIndex(0u)
+    , numChannels(0u)
+    , sourceSize(0u)
     , duration(0.0f)
     , ticksPerSecond(0.0f)
   { }
@@ -41,6 +388,19 @@ namespace Strontium
     this->duration = animation->mDuration;
     this->ticksPerSecond = animation->mTicksPerSecond == 0.0f ? 25.0f : animation->mTicksPerSecond;
 
+    this->readKeys(animation);
+    this->compile();
+
+    // Only the compiled clip is sampled. Keep the source keys if they can't
+    // be reloaded.
+    if (!this->sourcePath.empty())
+      this->releaseSourceKeys();
+  }
+
+  void
+  Animation::readKeys(const aiAnimation* animation)
+  {
+    this->animationNodes.clear();
     for (uint i = 0; i < animation->mNumChannels; i++)
     {
       aiNodeAnim* node = animation->mChannels[i];
@@ -73,6 +433,155 @@ namespace Strontium
         }
       }
     }
+
+    this->numChannels = this->animationNodes.size();
+    this->sourceSize = 0u;
+    for (auto& [name, node] : this->animationNodes)
+    {
+      this->sourceSize += node.keyTranslations.size() * sizeof(std::pair<float, glm::vec3>);
+      this->sourceSize += node.keyRotations.size() * sizeof(std::pair<float, glm::quat>);
+      this->sourceSize += node.keyScales.size() * sizeof(std::pair<float, glm::vec3>);
+    }
+  }
+
+  bool
+  Animation::loadSourceKeys()
+  {
+    if (this->hasSourceKeys())
+      return true;
+
+    if (this->sourcePath.empty())
+      return false;
+
+    // Only the animations are needed, skip the mesh post processing.
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(this->sourcePath, aiProcess_ValidateDataStructure);
+    if (!scene || this->sourceIndex >= scene->mNumAnimations)
+    {
+      Logs::log("Failed to reload the keys of " + this->name + " from " + this->sourcePath + ".");
+      return false;
+    }
+
+    this->readKeys(scene->mAnimations[this->sourceIndex]);
+    return true;
+  }
+
+  void
+  Animation::releaseSourceKeys()
+  {
+    // Swap with an empty map, clearing keeps the allocation.
+    robin_hood::unordered_flat_map<std::string, AnimationNode>().swap(this->animationNodes);
+  }
+
+  // Flatten the model's node hierarchy and compress the channels into flat
+  // tracks. Requires the model's nodes and bones to be loaded.
+  void
+  Animation::compile()
+  {
+    this->compiled = CompiledAnimation();
+    auto& compiled = this->compiled;
+    auto& sceneNodes = this->parentModel->getSceneNodes();
+    auto& boneMap = this->parentModel->getBoneMap();
+    auto& bones = this->parentModel->getBones();
+
+    // Times are quantized over the whole clip.
+    compiled.timeStep = this->duration > 0.0f ? this->duration / 65535.0f : 1.0f;
+
+    auto translationDistance = [](const glm::vec3 &a, const glm::vec3 &b) { return glm::length(a - b); };
+    auto scaleDistance = [](const glm::vec3 &a, const glm::vec3 &b)
+    {
+      const glm::vec3 difference = glm::abs(a - b);
+      return glm::max(difference.x, glm::max(difference.y, difference.z));
+    };
+
+    // Depth first, so parents come before their children.
+    std::vector<std::pair<const SceneNode*, int>> stack;
+    stack.emplace_back(&this->parentModel->getRootNode(), -1);
+    while (!stack.empty())
+    {
+      auto [node, parent] = stack.back();
+      stack.pop_back();
+
+      const int index = static_cast<int>(compiled.nodeNames.size());
+      compiled.nodeNames.push_back(node->name);
+      compiled.parents.push_back(parent);
+      compiled.bindTransforms.push_back(node->localTransform);
+
+      auto bone = boneMap.find(node->name);
+      if (bone != boneMap.end())
+      {
+        compiled.boneIndices.push_back(static_cast<int>(bone->second));
+        compiled.boneOffsets.push_back(bones[bone->second].offsetMatrix);
+      }
+      else
+      {
+        compiled.boneIndices.push_back(-1);
+        compiled.boneOffsets.push_back(glm::mat4(1.0f));
+      }
+
+      auto channel = this->animationNodes.find(node->name);
+      if (channel != this->animationNodes.end() && !channel->second.keyTranslations.empty()
+          && !channel->second.keyRotations.empty() && !channel->second.keyScales.empty())
+      {
+        auto& animationNode = channel->second;
+        compiled.tracks.push_back(static_cast<int>(compiled.translationTracks.size()));
+        const float translationError = compressVec3Track(animationNode.keyTranslations, compiled.timeStep,
+                                                         this->compression.maxTranslationError, translationDistance,
+                                                         compiled.translationTracks, compiled.translationRanges,
+                                                         compiled.translationTimes, compiled.translationKeys,
+                                                         compiled.translationLowKeys);
+        const float rotationError = compressQuatTrack(animationNode.keyRotations, compiled.timeStep,
+                                                      this->compression.maxRotationError, compiled.rotationTracks,
+                                                      compiled.rotationTimes, compiled.rotationKeys);
+        const float scaleError = compressVec3Track(animationNode.keyScales, compiled.timeStep,
+                                                   this->compression.maxScaleError, scaleDistance,
+                                                   compiled.scaleTracks, compiled.scaleRanges, compiled.scaleTimes,
+                                                   compiled.scaleKeys, compiled.scaleLowKeys);
+        compiled.translationError = glm::max(compiled.translationError, translationError);
+        compiled.rotationError = glm::max(compiled.rotationError, rotationError);
+        compiled.scaleError = glm::max(compiled.scaleError, scaleError);
+      }
+      else
+        compiled.tracks.push_back(-1);
+
+      for (auto child = node->childNames.rbegin(); child != node->childNames.rend(); ++child)
+      {
+        auto childNode = sceneNodes.find(*child);
+        if (childNode != sceneNodes.end())
+          stack.emplace_back(&childNode->second, index);
+      }
+    }
+  }
+
+  // Recompressing needs the source keys. Release them again afterwards
+  // unless they were already loaded.
+  void
+  Animation::setCompression(const AnimationCompression &compression)
+  {
+    const bool hadSourceKeys = this->hasSourceKeys();
+    if (!this->loadSourceKeys())
+      return;
+
+    this->compression = compression;
+    this->compile();
+
+    if (!hadSourceKeys)
+      this->releaseSourceKeys();
+  }
+
+  uint
+  Animation::getCompressedSize() const
+  {
+    auto& compiled = this->compiled;
+    const uint numKeys = compiled.translationKeys.size() + compiled.rotationKeys.size() + compiled.scaleKeys.size();
+    const uint numTracks = compiled.translationTracks.size() + compiled.rotationTracks.size()
+                           + compiled.scaleTracks.size();
+
+    const uint numLowKeys = compiled.translationLowKeys.size() + compiled.scaleLowKeys.size();
+
+    return numKeys * (sizeof(ushort) + sizeof(PackedAnimationKey)) + numLowKeys * sizeof(PackedAnimationKey)
+           + numTracks * sizeof(AnimationTrack)
+           + (compiled.translationRanges.size() + compiled.scaleRanges.size()) * sizeof(AnimationKeyRange);
   }
 
   uint 
@@ -81,9 +590,117 @@ namespace Strontium
     return this->parentModel->getBones().size(); 
   }
 
+  bool
+  Animation::isSkinned() const
+  {
+    return this->parentModel->hasSkins();
+  }
+
+  void
+  Animation::evaluateNodes(float aniTime, AnimationCursor &cursor)
+  {
+    auto& compiled = this->compiled;
+    const uint numNodes = compiled.nodeNames.size();
+    const uint numTracks = compiled.translationTracks.size();
+
+    if (cursor.animation != this || cursor.translationKeys.size() != numTracks)
+    {
+      cursor.animation = this;
+      cursor.translationKeys.assign(numTracks, 0u);
+      cursor.rotationKeys.assign(numTracks, 0u);
+      cursor.scaleKeys.assign(numTracks, 0u);
+    }
+    auto& nodeTransforms = cursor.nodeTransforms;
+    nodeTransforms.resize(numNodes);
+
+    // Key times are quantized, compare against the quantized time.
+    const float keyTime = aniTime / compiled.timeStep;
+
+    // Parents come first, so one pass accumulates the global transforms.
+    for (uint i = 0; i < numNodes; i++)
+    {
+      glm::mat4 nodeTransform = compiled.bindTransforms[i];
+      const int track = compiled.tracks[i];
+      if (track >= 0)
+      {
+        const glm::vec3 translation = sampleVec3(compiled.translationTracks[track], compiled.translationRanges[track],
+                                                 compiled.translationTimes, compiled.translationKeys,
+                                                 compiled.translationLowKeys, keyTime, cursor.translationKeys[track]);
+        const glm::quat rotation = sampleQuat(compiled.rotationTracks[track], compiled.rotationTimes,
+                                              compiled.rotationKeys, keyTime, cursor.rotationKeys[track]);
+        const glm::vec3 scale = sampleVec3(compiled.scaleTracks[track], compiled.scaleRanges[track],
+                                           compiled.scaleTimes, compiled.scaleKeys, compiled.scaleLowKeys,
+                                           keyTime, cursor.scaleKeys[track]);
+
+        // Translation * rotation * scale without the matrix products.
+        nodeTransform = glm::toMat4(rotation);
+        nodeTransform[0] *= scale.x;
+        nodeTransform[1] *= scale.y;
+        nodeTransform[2] *= scale.z;
+        nodeTransform[3] = glm::vec4(translation, 1.0f);
+      }
+
+      const int parent = compiled.parents[i];
+      multiplyMatrices(parent >= 0 ? nodeTransforms[parent] : this->parentModel->getGlobalTransform(),
+                       nodeTransform, nodeTransforms[i]);
+    }
+  }
+
   void
   Animation::computeBoneTransforms(float aniTime, std::vector<glm::mat4>& outBonesSkinned, 
-                                   robin_hood::unordered_flat_map<std::string, glm::mat4> &outBonesUnskinned)
+                                   robin_hood::unordered_flat_map<std::string, glm::mat4> &outBonesUnskinned,
+                                   AnimationCursor* cursor)
+  {
+    if (this->parentModel->hasSkins())
+    {
+      // Compute the transformations for a skinned model.
+      outBonesSkinned.clear();
+      outBonesSkinned.resize(this->parentModel->getBones().size(), glm::mat4(1.0f));
+      this->computeSkinnedPose(aniTime, outBonesSkinned.data(), cursor);
+      return;
+    }
+
+    // Without a cursor, search every track from the start.
+    AnimationCursor localCursor;
+    AnimationCursor &keyCursor = cursor ? *cursor : localCursor;
+    this->evaluateNodes(aniTime, keyCursor);
+
+    // Compute the transformations for an unskinned model.
+    auto& compiled = this->compiled;
+    const glm::mat4 &globalInverse = this->parentModel->getGlobalInverseTransform();
+    outBonesUnskinned.clear();
+    for (uint i = 0; i < compiled.nodeNames.size(); i++)
+      outBonesUnskinned.emplace(compiled.nodeNames[i], globalInverse * keyCursor.nodeTransforms[i]);
+  }
+
+  void
+  Animation::computeSkinnedPose(float aniTime, glm::mat4* outBones, AnimationCursor* cursor)
+  {
+    AnimationCursor localCursor;
+    AnimationCursor &keyCursor = cursor ? *cursor : localCursor;
+    this->evaluateNodes(aniTime, keyCursor);
+
+    auto& compiled = this->compiled;
+    const glm::mat4 &globalInverse = this->parentModel->getGlobalInverseTransform();
+    const uint numBones = this->parentModel->getBones().size();
+    for (uint i = 0; i < numBones; i++)
+      outBones[i] = glm::mat4(1.0f);
+
+    glm::mat4 boneTransform;
+    for (uint i = 0; i < compiled.nodeNames.size(); i++)
+    {
+      const int bone = compiled.boneIndices[i];
+      if (bone < 0)
+        continue;
+
+      multiplyMatrices(globalInverse, keyCursor.nodeTransforms[i], boneTransform);
+      multiplyMatrices(boneTransform, compiled.boneOffsets[i], outBones[bone]);
+    }
+  }
+
+  void
+  Animation::computeBoneTransformsReference(float aniTime, std::vector<glm::mat4>& outBonesSkinned, 
+                                            robin_hood::unordered_flat_map<std::string, glm::mat4> &outBonesUnskinned)
   {
     if (this->parentModel->hasSkins())
     {
@@ -247,6 +864,11 @@ namespace Strontium
     : storedModel("")
     , storedAnimation(nullptr)
     , currentAniTime(0.0f)
+    , sharedPalette(nullptr)
+    , visible(true)
+    , screenHeight(std::numeric_limits<float>::max())
+    , blendFrames(0u)
+    , blendFrame(0u)
     , animating(false)
     , paused(true)
     , scrubbing(false)
@@ -262,26 +884,111 @@ namespace Strontium
       this->storedModel = modelHandle;
       this->storedAnimation = animation;
       this->currentAniTime = 0.0f;
+      this->cursor.reset();
+      this->sharedPalette = nullptr;
+      this->resetBlend();
     }
   }
 
-  void
-  Animator::onUpdate(float dt)
+  bool
+  Animator::advance(float dt)
   {
-    if (this->storedAnimation && this->animating && !this->paused)
+    if (!this->storedAnimation)
+    {
+      this->scrubbing = false;
+      return false;
+    }
+
+    bool evaluate = false;
+    if (this->animating && !this->paused)
     {
       this->currentAniTime += dt * this->storedAnimation->getTPS();
       this->currentAniTime = fmod(this->currentAniTime, this->storedAnimation->getDuration());
-
-      this->storedAnimation->computeBoneTransforms(this->currentAniTime, this->finalBoneTransforms, 
-                                                   this->unSkinnedFinalTransforms);
+      evaluate = true;
     }
 
     if (this->scrubbing)
     {
       this->scrubbing = false;
-      this->storedAnimation->computeBoneTransforms(this->currentAniTime, this->finalBoneTransforms, 
-                                                   this->unSkinnedFinalTransforms);
+      evaluate = true;
     }
+
+    return evaluate;
+  }
+
+  void
+  Animator::evaluate()
+  {
+    this->sharedPalette = nullptr;
+    this->storedAnimation->computeBoneTransforms(this->currentAniTime, this->finalBoneTransforms, 
+                                                 this->unSkinnedFinalTransforms, &this->cursor);
+  }
+
+  void
+  Animator::onUpdate(float dt)
+  {
+    if (this->advance(dt))
+      this->evaluate();
+  }
+
+  void
+  Animator::detachPose()
+  {
+    if (!this->sharedPalette)
+      return;
+
+    const uint numBones = this->storedAnimation ? this->storedAnimation->getNumBones() : 0u;
+    this->finalBoneTransforms.assign(this->sharedPalette, this->sharedPalette + numBones);
+    this->sharedPalette = nullptr;
+  }
+
+  void
+  Animator::beginBlend(float aheadTicks, uint numFrames)
+  {
+    const uint numBones = this->storedAnimation->getNumBones();
+
+    // Start from the current pose unless a blend was already running, the
+    // pose shown last may be stale.
+    if (!this->isBlending() || this->sharedPalette || this->finalBoneTransforms.size() != numBones)
+      this->evaluate();
+    this->blendStart = this->finalBoneTransforms;
+
+    const float targetTime = fmod(this->currentAniTime + aheadTicks, this->storedAnimation->getDuration());
+    this->blendTarget.resize(numBones);
+    this->storedAnimation->computeSkinnedPose(targetTime, this->blendTarget.data(), &this->cursor);
+
+    this->blendFrames = numFrames;
+    this->blendFrame = 0u;
+  }
+
+  void
+  Animator::stepBlend()
+  {
+    if (this->blendFrame >= this->blendFrames)
+      return;
+
+    this->blendFrame++;
+    const float factor = static_cast<float>(this->blendFrame) / static_cast<float>(this->blendFrames);
+
+    // Blending the bone matrices isn't a proper interpolation, but the steps
+    // are only a few frames long and the animator is small on screen.
+    this->finalBoneTransforms.resize(this->blendTarget.size());
+    for (uint i = 0; i < this->blendTarget.size(); i++)
+      this->finalBoneTransforms[i] = this->blendStart[i] + (this->blendTarget[i] - this->blendStart[i]) * factor;
+    this->sharedPalette = nullptr;
+  }
+
+  const glm::mat4*
+  Animator::getBonePalette() const
+  {
+    return this->sharedPalette ? this->sharedPalette : this->finalBoneTransforms.data();
+  }
+
+  uint
+  Animator::getNumBones() const
+  {
+    if (this->sharedPalette)
+      return this->storedAnimation->getNumBones();
+    return this->finalBoneTransforms.size();
   }
 }
@@ -359,7 +359,9 @@ namespace Strontium
   void
   DrawIndirectBuffer::bindToPoint(const uint bindPoint)
   {
-    glBindBufferBase(GL_DRAW_INDIRECT_BUFFER, bindPoint, this->bufferID);
+    // The draw indirect target isn't indexed, bind as a storage buffer so 
+    // compute shaders can write commands.
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindPoint, this->bufferID);
   }
 
   void
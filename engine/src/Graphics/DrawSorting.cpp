@@ -0,0 +1,114 @@
+#include "Graphics/DrawSorting.h"
+
+// Project includes.
+#include "Graphics/Textures.h"
+
+namespace Strontium
+{
+  TextureBindCache::TextureBindCache()
+    : numBinds(0u)
+    , numSkipped(0u)
+  {
+    this->reset();
+  }
+
+  void
+  TextureBindCache::reset()
+  {
+    for (uint i = 0; i < MAX_TRACKED_TEXTURE_UNITS; i++)
+      this->boundTextures[i] = 0u;
+  }
+
+  void
+  TextureBindCache::bind(Texture2D* texture, uint unit)
+  {
+    if (unit >= MAX_TRACKED_TEXTURE_UNITS)
+    {
+      texture->bind(unit);
+      this->numBinds++;
+      return;
+    }
+
+    if (this->boundTextures[unit] == texture->getID())
+    {
+      this->numSkipped++;
+      return;
+    }
+
+    texture->bind(unit);
+    this->boundTextures[unit] = texture->getID();
+    this->numBinds++;
+  }
+
+  void
+  TextureBindCache::bind(Texture2DArray* texture, uint unit)
+  {
+    if (unit >= MAX_TRACKED_TEXTURE_UNITS)
+    {
+      texture->bind(unit);
+      this->numBinds++;
+      return;
+    }
+
+    if (this->boundTextures[unit] == texture->getID())
+    {
+      this->numSkipped++;
+      return;
+    }
+
+    texture->bind(unit);
+    this->boundTextures[unit] = texture->getID();
+    this->numBinds++;
+  }
+}
+
+namespace Strontium::DrawSorting
+{
+  ulong
+  packKey(DrawSortPass pass, uint shaderID, uint materialID, float depth, float maxDepth)
+  {
+    const float normalizedDepth = maxDepth > 0.0f ? glm::clamp(depth / maxDepth, 0.0f, 1.0f) : 0.0f;
+    const ulong depthBucket = static_cast<ulong>(normalizedDepth * static_cast<float>(0xFFFFFFu));
+
+    return (static_cast<ulong>(static_cast<uint>(pass) & 0xFu) << 60u)
+           | (static_cast<ulong>(shaderID & 0xFFFu) << 48u)
+           | (static_cast<ulong>(materialID & 0xFFFFFFu) << 24u)
+           | depthBucket;
+  }
+
+  void
+  radixSort(std::vector<SortedDraw> &draws, std::vector<SortedDraw> &scratch)
+  {
+    if (draws.size() < 2u)
+      return;
+
+    scratch.resize(draws.size());
+
+    uint counts[256];
+    for (uint shift = 0u; shift < 64u; shift += 8u)
+    {
+      for (uint i = 0; i < 256; i++)
+        counts[i] = 0u;
+
+      for (auto& draw : draws)
+        counts[(draw.key >> shift) & 0xFFu]++;
+
+      // All the keys share this byte, nothing to do.
+      if (counts[(draws[0].key >> shift) & 0xFFu] == draws.size())
+        continue;
+
+      uint offset = 0u;
+      for (uint i = 0; i < 256; i++)
+      {
+        const uint count = counts[i];
+        counts[i] = offset;
+        offset += count;
+      }
+
+      for (auto& draw : draws)
+        scratch[counts[(draw.key >> shift) & 0xFFu]++] = draw;
+
+      draws.swap(scratch);
+    }
+  }
+}
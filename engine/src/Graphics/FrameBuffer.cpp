@@ -8,6 +8,19 @@
 
 namespace Strontium
 {
+  static bool
+  isIntegerFormat(TextureFormats format)
+  {
+    return format == TextureFormats::RedInt || format == TextureFormats::RGInt 
+           || format == TextureFormats::RGBInt || format == TextureFormats::RGBAInt;
+  }
+
+  static bool
+  isUnsignedFormat(TextureInternalFormats format)
+  {
+    return format == TextureInternalFormats::R32ui || format == TextureInternalFormats::RG32ui;
+  }
+
   FrameBuffer::FrameBuffer()
     : depthBuffer()
     , width(1)
@@ -195,11 +208,39 @@ namespace Strontium
     }
   }
 
+  void
+  FrameBuffer::blitzRegionToOther(FrameBuffer &target, const FBOTargetParam &type,
+                                  uint xMin, uint yMin, uint oWidth, uint oHeight)
+  {
+    uint mask = GL_COLOR_BUFFER_BIT;
+    if (type == FBOTargetParam::Depth)
+      mask = GL_DEPTH_BUFFER_BIT;
+    else if (type == FBOTargetParam::Stencil)
+      mask = GL_STENCIL_BUFFER_BIT;
+    else if (type == FBOTargetParam::DepthStencil)
+      mask = GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+
+    glBlitNamedFramebuffer(this->bufferID, target.getID(), xMin, yMin,
+                           xMin + oWidth, yMin + oHeight, xMin, yMin,
+                           xMin + oWidth, yMin + oHeight, mask, GL_NEAREST);
+  }
+
   int
   FrameBuffer::readPixel(const FBOTargetParam &target, const glm::vec2 &mousePos)
   {
     this->bind();
     glReadBuffer(static_cast<GLenum>(target));
+
+    // Integer attachments are read back exactly.
+    auto& attachment = this->textureAttachments.at(target);
+    if (isIntegerFormat(attachment.format))
+    {
+      int data = 0;
+      glReadPixels(static_cast<int>(mousePos.x), static_cast<int>(mousePos.y), 1, 1, GL_RED_INTEGER, 
+                   static_cast<GLenum>(attachment.dataType), &data);
+      return data;
+    }
+
     float data;
     glReadPixels(static_cast<int>(mousePos.x), static_cast<int>(mousePos.y), 1, 1, GL_RED, GL_FLOAT, &data);
     return static_cast<int>(glm::round(data));
@@ -311,9 +352,55 @@ namespace Strontium
     glClearColor(this->clearColour[0], this->clearColour[1], this->clearColour[2],
                  this->clearColour[3]);
     glClear(this->clearFlags);
+    this->clearIntegerAttachments();
+    this->unbind();
+  }
+
+  // Clear a region of the framebuffer.
+  void
+  FrameBuffer::clear(uint xMin, uint yMin, uint oWidth, uint oHeight)
+  {
+    this->bind();
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(xMin, yMin, oWidth, oHeight);
+    glClearColor(this->clearColour[0], this->clearColour[1], this->clearColour[2],
+                 this->clearColour[3]);
+    glClear(this->clearFlags);
+    this->clearIntegerAttachments();
+    glDisable(GL_SCISSOR_TEST);
     this->unbind();
   }
 
+  // glClear leaves integer attachments undefined, clear them with the clear
+  // colour converted to integers. Colour attachments are in draw buffer
+  // order, same as setDrawBuffers().
+  void
+  FrameBuffer::clearIntegerAttachments()
+  {
+    int drawBuffer = 0;
+    for (auto& [target, attachment] : this->textureAttachments)
+    {
+      if (target == FBOTargetParam::Depth || target == FBOTargetParam::Stencil
+          || target == FBOTargetParam::DepthStencil)
+        continue;
+
+      if (isIntegerFormat(attachment.format))
+      {
+        if (isUnsignedFormat(attachment.internal))
+        {
+          const glm::uvec4 value = glm::uvec4(this->clearColour);
+          glClearBufferuiv(GL_COLOR, drawBuffer, &value[0]);
+        }
+        else
+        {
+          const glm::ivec4 value = glm::ivec4(this->clearColour);
+          glClearBufferiv(GL_COLOR, drawBuffer, &value[0]);
+        }
+      }
+      drawBuffer++;
+    }
+  }
+
   bool
   FrameBuffer::isValid()
   {
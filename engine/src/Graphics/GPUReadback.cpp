@@ -0,0 +1,197 @@
+#include "Graphics/GPUReadback.h"
+
+// Project includes.
+#include "Graphics/Buffers.h"
+
+// OpenGL includes.
+#include "glad/glad.h"
+
+namespace Strontium
+{
+  AsynchReadback::AsynchReadback(uint size, uint numBuffers)
+    : size(size)
+    , start(0u)
+    , count(0u)
+    , capacity(numBuffers)
+  {
+    assert(("Must generate at least one staging buffer.", numBuffers > 0u));
+
+    this->buffers = new uint[numBuffers];
+    this->fences = new void*[numBuffers];
+
+    glCreateBuffers(numBuffers, this->buffers);
+    for (uint i = 0; i < numBuffers; i++)
+    {
+      glNamedBufferStorage(this->buffers[i], size, nullptr, GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT);
+      this->fences[i] = nullptr;
+    }
+  }
+
+  AsynchReadback::~AsynchReadback()
+  {
+    this->reset();
+
+    glDeleteBuffers(this->capacity, this->buffers);
+    delete[] this->buffers;
+    delete[] this->fences;
+  }
+
+  bool
+  AsynchReadback::queueCopy(ShaderStorageBuffer &source, uint offset)
+  {
+    if (this->count == this->capacity)
+      return false;
+
+    const uint index = (this->start + this->count) % this->capacity;
+    glCopyNamedBufferSubData(source.getID(), this->buffers[index], offset, 0, this->size);
+    this->fences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    this->count++;
+
+    return true;
+  }
+
+  bool
+  AsynchReadback::fetch(void* outData)
+  {
+    // Skip ahead to the newest copy which has finished.
+    bool fetched = false;
+    while (this->count > 0u)
+    {
+      GLsync fence = static_cast<GLsync>(this->fences[this->start]);
+      const GLenum status = glClientWaitSync(fence, 0, 0);
+      if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        break;
+
+      glGetNamedBufferSubData(this->buffers[this->start], 0, this->size, outData);
+      glDeleteSync(fence);
+      this->fences[this->start] = nullptr;
+
+      this->start = (this->start + 1u) % this->capacity;
+      this->count--;
+      fetched = true;
+    }
+
+    return fetched;
+  }
+
+  void
+  AsynchReadback::reset()
+  {
+    for (uint i = 0; i < this->count; i++)
+    {
+      const uint index = (this->start + i) % this->capacity;
+      glDeleteSync(static_cast<GLsync>(this->fences[index]));
+      this->fences[index] = nullptr;
+    }
+
+    this->start = 0u;
+    this->count = 0u;
+  }
+
+  AsynchPixelReadback::AsynchPixelReadback(uint numBuffers)
+    : start(0u)
+    , count(0u)
+    , capacity(numBuffers)
+  {
+    assert(("Must generate at least one pixel buffer.", numBuffers > 0u));
+
+    this->buffers = new uint[numBuffers];
+    this->bufferSizes = new uint[numBuffers];
+    this->fences = new void*[numBuffers];
+    this->regions = new glm::ivec4[numBuffers];
+
+    // Regions vary in size, the pixel buffers are grown when they're used.
+    glCreateBuffers(numBuffers, this->buffers);
+    for (uint i = 0; i < numBuffers; i++)
+    {
+      this->bufferSizes[i] = 0u;
+      this->fences[i] = nullptr;
+    }
+  }
+
+  AsynchPixelReadback::~AsynchPixelReadback()
+  {
+    this->reset();
+
+    glDeleteBuffers(this->capacity, this->buffers);
+    delete[] this->buffers;
+    delete[] this->bufferSizes;
+    delete[] this->fences;
+    delete[] this->regions;
+  }
+
+  bool
+  AsynchPixelReadback::queueRead(FrameBuffer &source, const FBOTargetParam &target,
+                                 const glm::ivec2 &offset, const glm::ivec2 &extent)
+  {
+    if (this->count == this->capacity)
+      return false;
+
+    const glm::ivec2 size = glm::ivec2(source.getSize());
+    const glm::ivec2 minCorner = glm::clamp(offset, glm::ivec2(0), size);
+    const glm::ivec2 maxCorner = glm::clamp(offset + extent, glm::ivec2(0), size);
+    const glm::ivec2 clampedExtent = maxCorner - minCorner;
+    if (clampedExtent.x <= 0 || clampedExtent.y <= 0)
+      return false;
+
+    const uint index = (this->start + this->count) % this->capacity;
+    const uint readSize = sizeof(uint) * static_cast<uint>(clampedExtent.x * clampedExtent.y);
+    if (this->bufferSizes[index] < readSize)
+    {
+      glNamedBufferData(this->buffers[index], readSize, nullptr, GL_STREAM_READ);
+      this->bufferSizes[index] = readSize;
+    }
+
+    // Read into the pixel buffer, the copy happens on the GPU timeline.
+    source.bind();
+    glReadBuffer(static_cast<GLenum>(target));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, this->buffers[index]);
+    glReadPixels(minCorner.x, minCorner.y, clampedExtent.x, clampedExtent.y, GL_RED_INTEGER,
+                 GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    source.unbind();
+
+    this->fences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    this->regions[index] = glm::ivec4(minCorner, clampedExtent);
+    this->count++;
+
+    return true;
+  }
+
+  bool
+  AsynchPixelReadback::fetch(std::vector<uint> &outData, glm::ivec4 &outRegion)
+  {
+    if (this->count == 0u)
+      return false;
+
+    GLsync fence = static_cast<GLsync>(this->fences[this->start]);
+    const GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+      return false;
+
+    outRegion = this->regions[this->start];
+    outData.resize(static_cast<uint>(outRegion.z * outRegion.w));
+    glGetNamedBufferSubData(this->buffers[this->start], 0, sizeof(uint) * outData.size(), outData.data());
+    glDeleteSync(fence);
+    this->fences[this->start] = nullptr;
+
+    this->start = (this->start + 1u) % this->capacity;
+    this->count--;
+
+    return true;
+  }
+
+  void
+  AsynchPixelReadback::reset()
+  {
+    for (uint i = 0; i < this->count; i++)
+    {
+      const uint index = (this->start + i) % this->capacity;
+      glDeleteSync(static_cast<GLsync>(this->fences[index]));
+      this->fences[index] = nullptr;
+    }
+
+    this->start = 0u;
+    this->count = 0u;
+  }
+}
@@ -5,6 +5,25 @@
 
 namespace Strontium
 {
+  // The entity ID texture. Holds the entity ID + 1 (r) and the selection
+  // mask (g).
+  static void
+  attachEntityIDs(FrameBuffer &buffer)
+  {
+    Texture2DParams idSpec;
+    idSpec.sWrap = TextureWrapParams::ClampEdges;
+    idSpec.tWrap = TextureWrapParams::ClampEdges;
+    idSpec.minFilter = TextureMinFilterParams::Nearest;
+    idSpec.maxFilter = TextureMaxFilterParams::Nearest;
+    idSpec.internal = TextureInternalFormats::RG32ui;
+    idSpec.format = TextureFormats::RGInt;
+    idSpec.dataType = TextureDataType::UInt;
+
+    auto attachment = FBOAttachment(FBOTargetParam::Colour4, FBOTextureParam::Texture2D,
+                                    idSpec.internal, idSpec.format, idSpec.dataType);
+    buffer.attach(idSpec, attachment);
+  }
+
   GeometryBuffer::GeometryBuffer()
     : geoBuffer(1, 1)
   {
@@ -29,9 +48,10 @@ namespace Strontium
     // The lighting materials texture.
     attachment.target = FBOTargetParam::Colour2;
     this->geoBuffer.attach(cSpec, attachment);
-    // The ID texture with a mask for the current selected entity.
+    // The emission and anisotropic texture.
     attachment.target = FBOTargetParam::Colour3;
     this->geoBuffer.attach(cSpec, attachment);
+    attachEntityIDs(this->geoBuffer);
     this->geoBuffer.setDrawBuffers();
 
     attachment = FBOAttachment(FBOTargetParam::Depth, FBOTextureParam::Texture2D,
@@ -67,6 +87,8 @@ namespace Strontium
     attachment.target = FBOTargetParam::Colour3;
     this->geoBuffer.attach(cSpec, attachment);
 
+    attachEntityIDs(this->geoBuffer);
+
     this->geoBuffer.setDrawBuffers();
 
     auto depthAttachment = FBOAttachment(FBOTargetParam::Depth, FBOTextureParam::Texture2D,
@@ -8,12 +8,66 @@
 #include "Assets/MaterialAsset.h"
 
 #include "Graphics/Buffers.h"
+#include "Graphics/DrawSorting.h"
+
+// STL includes.
+#include <atomic>
+#include <mutex>
 
 namespace Strontium
 {
+  // Every live material by ID. Materials can be created on the loading
+  // threads, so the registry is locked. Freed IDs are reused to keep the
+  // IDs dense.
+  struct MaterialRegistry
+  {
+    std::mutex lock;
+    std::vector<Material*> materials;
+    std::vector<uint> freeIDs;
+  };
+
+  static MaterialRegistry&
+  getMaterialRegistry()
+  {
+    static MaterialRegistry registry;
+    return registry;
+  }
+
+  static std::atomic<uint> nextRevision(0u);
+
+  static uint
+  registerMaterial(Material* material)
+  {
+    auto& registry = getMaterialRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    if (!registry.freeIDs.empty())
+    {
+      const uint id = registry.freeIDs.back();
+      registry.freeIDs.pop_back();
+      registry.materials[id] = material;
+      return id;
+    }
+
+    registry.materials.push_back(material);
+    return registry.materials.size() - 1u;
+  }
+
+  static void
+  unregisterMaterial(uint id)
+  {
+    auto& registry = getMaterialRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    registry.materials[id] = nullptr;
+    registry.freeIDs.push_back(id);
+  }
+
   Material::Material(Type type)
     : type(type)
     , pipeline(false)
+    , materialID(0u)
+    , revision(nextRevision++)
   {
     switch (type)
     {
@@ -48,17 +102,43 @@ namespace Strontium
         break;
       }
     }
+
+    // Only visible to the renderer once the default parameters exist.
+    this->materialID = registerMaterial(this);
   }
 
   Material::~Material()
-  { }
+  {
+    unregisterMaterial(this->materialID);
+  }
+
+  void
+  Material::forEachMaterial(const std::function<void(Material*)> &visitor)
+  {
+    auto& registry = getMaterialRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    for (auto material : registry.materials)
+    {
+      if (material)
+        visitor(material);
+    }
+  }
+
+  void
+  Material::markEdited()
+  {
+    this->revision = nextRevision++;
+  }
 
   MaterialBlockData
   Material::getPackedUniformData()
   {
+    // Textures aren't paged by default.
     return { { this->getfloat("uMetallic"), this->getfloat("uRoughness"), 
                this->getfloat("uAO"), this->getfloat("uEmiss") },
-             { this->getvec3("uAlbedo"), this->getfloat("uReflectance") } };
+             { this->getvec3("uAlbedo"), this->getfloat("uReflectance") },
+             glm::vec4(-1.0f), glm::vec4(-1.0f) };
   }
 
   void
@@ -105,6 +185,21 @@ namespace Strontium
     this->getSampler2D("emissionMap")->bind(6);
   }
 
+  void
+  Material::configureTextures(TextureBindCache &cache, bool bindOnlyAlbedo)
+  {
+    cache.bind(this->getSampler2D("albedoMap"), 0);
+    if (bindOnlyAlbedo)
+      return;
+
+    cache.bind(this->getSampler2D("normalMap"), 1);
+    cache.bind(this->getSampler2D("roughnessMap"), 2);
+    cache.bind(this->getSampler2D("metallicMap"), 3);
+    cache.bind(this->getSampler2D("aOcclusionMap"), 4);
+    cache.bind(this->getSampler2D("specF0Map"), 5);
+    cache.bind(this->getSampler2D("emissionMap"), 6);
+  }
+
   // Search for and attach textures to a sampler.
   bool
   Material::hasSampler1D(const std::string &samplerName)
@@ -133,6 +228,8 @@ namespace Strontium
   void
   Material::attachSampler2D(const std::string &samplerName, const Asset::Handle &handle)
   {
+    this->markEdited();
+
     if (!this->hasSampler2D(samplerName))
       this->sampler2Ds.push_back(std::pair(samplerName, handle));
     else
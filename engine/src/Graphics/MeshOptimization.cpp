@@ -0,0 +1,693 @@
+#include "Graphics/MeshOptimization.h"
+
+// Project includes.
+#include "Graphics/Meshes.h"
+
+// STL includes.
+#include <numeric>
+
+namespace Strontium::MeshOptimization
+{
+  //----------------------------------------------------------------------------
+  // Forsyth vertex cache optimization parameters.
+  //----------------------------------------------------------------------------
+  constexpr uint forsythCacheSize = 32u;
+  constexpr float forsythCacheDecayPower = 1.5f;
+  constexpr float forsythLastTriangleScore = 0.75f;
+  constexpr float forsythValenceBoostScale = 2.0f;
+  constexpr float forsythValenceBoostPower = 0.5f;
+
+  float
+  forsythVertexScore(int cachePosition, uint remainingValence)
+  {
+    // Vertices without any triangles left shouldn't be picked.
+    if (remainingValence == 0u)
+      return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+      // The last triangle's vertices get a fixed score so the optimizer
+      // doesn't favour strips.
+      if (cachePosition < 3)
+        score = forsythLastTriangleScore;
+      else
+      {
+        const float scaler = 1.0f / static_cast<float>(forsythCacheSize - 3u);
+        score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler,
+                         forsythCacheDecayPower);
+      }
+    }
+
+    // Boost vertices with few triangles left so we don't leave lone triangles behind.
+    score += forsythValenceBoostScale * std::pow(static_cast<float>(remainingValence),
+                                                 -forsythValenceBoostPower);
+
+    return score;
+  }
+
+  VertexCacheStatistics
+  analyzeVertexCache(const std::vector<uint> &indices, uint numVertices, uint cacheSize)
+  {
+    VertexCacheStatistics outStats;
+
+    const uint numTriangles = indices.size() / 3u;
+    if (numTriangles == 0u || numVertices == 0u)
+      return outStats;
+
+    // FIFO cache simulated with timestamps. A vertex is in the cache if it
+    // was inserted less than cacheSize insertions ago.
+    std::vector<uint> timestamps(numVertices, 0u);
+    std::vector<bool> referenced(numVertices, false);
+    uint timestamp = cacheSize + 1u;
+    uint numReferenced = 0u;
+    for (auto index : indices)
+    {
+      if (timestamp - timestamps[index] > cacheSize)
+      {
+        timestamps[index] = timestamp++;
+        outStats.numVerticesTransformed++;
+      }
+
+      if (!referenced[index])
+      {
+        referenced[index] = true;
+        numReferenced++;
+      }
+    }
+
+    outStats.acmr = static_cast<float>(outStats.numVerticesTransformed)
+                    / static_cast<float>(numTriangles);
+    outStats.atvr = static_cast<float>(outStats.numVerticesTransformed)
+                    / static_cast<float>(numReferenced);
+
+    return outStats;
+  }
+
+  void
+  optimizeVertexCache(std::vector<uint> &indices, uint numVertices)
+  {
+    const uint numTriangles = indices.size() / 3u;
+    if (numTriangles == 0u)
+      return;
+
+    // Build the vertex -> triangle adjacency.
+    std::vector<uint> valence(numVertices, 0u);
+    for (auto index : indices)
+      valence[index]++;
+
+    std::vector<uint> adjacencyOffsets(numVertices + 1u, 0u);
+    for (uint i = 0; i < numVertices; i++)
+      adjacencyOffsets[i + 1] = adjacencyOffsets[i] + valence[i];
+
+    std::vector<uint> adjacency(indices.size());
+    std::vector<uint> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint i = 0; i < numTriangles; i++)
+    {
+      for (uint j = 0; j < 3; j++)
+        adjacency[adjacencyFill[indices[3 * i + j]]++] = i;
+    }
+
+    // Initial scores.
+    std::vector<int> cachePositions(numVertices, -1);
+    std::vector<float> vertexScores(numVertices);
+    for (uint i = 0; i < numVertices; i++)
+      vertexScores[i] = forsythVertexScore(-1, valence[i]);
+
+    std::vector<float> triangleScores(numTriangles);
+    std::vector<bool> emitted(numTriangles, false);
+    int bestTriangle = -1;
+    float bestScore = -1.0f;
+    for (uint i = 0; i < numTriangles; i++)
+    {
+      triangleScores[i] = vertexScores[indices[3 * i]] + vertexScores[indices[3 * i + 1]]
+                          + vertexScores[indices[3 * i + 2]];
+
+      if (triangleScores[i] > bestScore)
+      {
+        bestScore = triangleScores[i];
+        bestTriangle = i;
+      }
+    }
+
+    std::vector<uint> outIndices;
+    outIndices.reserve(indices.size());
+
+    uint cache[forsythCacheSize + 3u];
+    uint newCache[forsythCacheSize + 3u];
+    uint cacheCount = 0u;
+    uint inputCursor = 0u;
+
+    while (bestTriangle >= 0)
+    {
+      const uint* triangle = &indices[3 * bestTriangle];
+      emitted[bestTriangle] = true;
+
+      // Emit the triangle and push its vertices to the front of the cache.
+      uint newCacheCount = 0u;
+      for (uint i = 0; i < 3; i++)
+      {
+        outIndices.push_back(triangle[i]);
+        valence[triangle[i]]--;
+        newCache[newCacheCount++] = triangle[i];
+      }
+
+      for (uint i = 0; i < cacheCount; i++)
+      {
+        const uint vertex = cache[i];
+        if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+          newCache[newCacheCount++] = vertex;
+      }
+
+      // Update the vertex scores, including the vertices which fell out of the cache.
+      for (uint i = 0; i < newCacheCount; i++)
+      {
+        const uint vertex = newCache[i];
+        cachePositions[vertex] = i < forsythCacheSize ? static_cast<int>(i) : -1;
+        vertexScores[vertex] = forsythVertexScore(cachePositions[vertex], valence[vertex]);
+      }
+
+      // Update the triangle scores of everything touching the cache and
+      // find the next best triangle.
+      bestTriangle = -1;
+      bestScore = -1.0f;
+      for (uint i = 0; i < newCacheCount; i++)
+      {
+        const uint vertex = newCache[i];
+        for (uint j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1]; j++)
+        {
+          const uint adjTriangle = adjacency[j];
+          if (emitted[adjTriangle])
+            continue;
+
+          triangleScores[adjTriangle] = vertexScores[indices[3 * adjTriangle]]
+                                        + vertexScores[indices[3 * adjTriangle + 1]]
+                                        + vertexScores[indices[3 * adjTriangle + 2]];
+
+          if (triangleScores[adjTriangle] > bestScore)
+          {
+            bestScore = triangleScores[adjTriangle];
+            bestTriangle = adjTriangle;
+          }
+        }
+      }
+
+      cacheCount = std::min(newCacheCount, forsythCacheSize);
+      std::copy(newCache, newCache + cacheCount, cache);
+
+      // Nothing in the cache is adjacent to a remaining triangle, restart at
+      // the next unemitted triangle in input order.
+      if (bestTriangle < 0)
+      {
+        while (inputCursor < numTriangles && emitted[inputCursor])
+          inputCursor++;
+
+        if (inputCursor < numTriangles)
+          bestTriangle = inputCursor;
+      }
+    }
+
+    indices = std::move(outIndices);
+  }
+
+  uint
+  optimizeOverdraw(std::vector<uint> &indices, const std::vector<PackedVertex> &vertices,
+                   float threshold)
+  {
+    const uint numTriangles = indices.size() / 3u;
+    if (numTriangles == 0u)
+      return 0u;
+
+    std::vector<uint> timestamps(vertices.size(), 0u);
+    uint timestamp = analysisCacheSize + 1u;
+
+    auto simulateTriangle = [&indices, &timestamps, &timestamp](uint triangle)
+    {
+      uint misses = 0u;
+      for (uint i = 0; i < 3; i++)
+      {
+        const uint index = indices[3 * triangle + i];
+        if (timestamp - timestamps[index] > analysisCacheSize)
+        {
+          timestamps[index] = timestamp++;
+          misses++;
+        }
+      }
+
+      return misses;
+    };
+
+    // Hard cluster boundaries are triangles where the cache was effectively
+    // flushed (every vertex missed).
+    std::vector<uint> hardClusters;
+    for (uint i = 0; i < numTriangles; i++)
+    {
+      if (simulateTriangle(i) == 3u || i == 0u)
+        hardClusters.push_back(i);
+    }
+    hardClusters.push_back(numTriangles);
+
+    // Soft cluster boundaries split hard clusters wherever the running ACMR
+    // falls under the threshold of the cluster's ACMR.
+    std::vector<uint> clusters;
+    for (uint i = 0; i < hardClusters.size() - 1; i++)
+    {
+      const uint start = hardClusters[i];
+      const uint end = hardClusters[i + 1];
+
+      timestamp += analysisCacheSize + 1u;
+      uint clusterMisses = 0u;
+      for (uint j = start; j < end; j++)
+        clusterMisses += simulateTriangle(j);
+      const float clusterACMR = static_cast<float>(clusterMisses)
+                                / static_cast<float>(end - start);
+
+      timestamp += analysisCacheSize + 1u;
+      uint clusterStart = start;
+      uint runningMisses = 0u;
+      clusters.push_back(start);
+      for (uint j = start; j < end - 1; j++)
+      {
+        runningMisses += simulateTriangle(j);
+        const float runningACMR = static_cast<float>(runningMisses)
+                                  / static_cast<float>(j - clusterStart + 1u);
+
+        if (runningACMR <= clusterACMR * threshold)
+        {
+          clusters.push_back(j + 1u);
+          clusterStart = j + 1u;
+          runningMisses = 0u;
+          timestamp += analysisCacheSize + 1u;
+        }
+      }
+    }
+    const uint numClusters = clusters.size();
+    clusters.push_back(numTriangles);
+
+    // Compute the area weighted centroid of the mesh and the centroid +
+    // normal of each cluster.
+    std::vector<glm::vec3> clusterCentroids(numClusters, glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormals(numClusters, glm::vec3(0.0f));
+    glm::vec3 meshCentroid = glm::vec3(0.0f);
+    float meshArea = 0.0f;
+    for (uint i = 0; i < numClusters; i++)
+    {
+      float clusterArea = 0.0f;
+      for (uint j = clusters[i]; j < clusters[i + 1]; j++)
+      {
+        const glm::vec3 p0 = glm::vec3(vertices[indices[3 * j]].position);
+        const glm::vec3 p1 = glm::vec3(vertices[indices[3 * j + 1]].position);
+        const glm::vec3 p2 = glm::vec3(vertices[indices[3 * j + 2]].position);
+
+        const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        const float area = glm::length(normal);
+
+        clusterCentroids[i] += (p0 + p1 + p2) * (area / 3.0f);
+        clusterNormals[i] += normal;
+        clusterArea += area;
+      }
+
+      meshCentroid += clusterCentroids[i];
+      meshArea += clusterArea;
+
+      clusterCentroids[i] = clusterArea > 0.0f ? clusterCentroids[i] / clusterArea
+                                               : glm::vec3(vertices[indices[3 * clusters[i]]].position);
+
+      const float normalLength = glm::length(clusterNormals[i]);
+      clusterNormals[i] = normalLength > 0.0f ? clusterNormals[i] / normalLength : glm::vec3(0.0f);
+    }
+    meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : meshCentroid;
+
+    // Sort clusters so the ones facing away from the center of the mesh are
+    // drawn first. These are the most likely to occlude the rest.
+    std::vector<float> sortKeys(numClusters);
+    for (uint i = 0; i < numClusters; i++)
+      sortKeys[i] = glm::dot(clusterCentroids[i] - meshCentroid, clusterNormals[i]);
+
+    std::vector<uint> clusterOrder(numClusters);
+    std::iota(clusterOrder.begin(), clusterOrder.end(), 0u);
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](uint a, uint b)
+    {
+      return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<uint> outIndices;
+    outIndices.reserve(indices.size());
+    for (auto cluster : clusterOrder)
+    {
+      outIndices.insert(outIndices.end(), indices.begin() + 3 * clusters[cluster],
+                        indices.begin() + 3 * clusters[cluster + 1]);
+    }
+    indices = std::move(outIndices);
+
+    return numClusters;
+  }
+
+  void
+  optimizeVertexFetch(std::vector<PackedVertex> &vertices, std::vector<uint> &indices)
+  {
+    constexpr uint unused = std::numeric_limits<uint>::max();
+
+    std::vector<uint> remap(vertices.size(), unused);
+    uint nextVertex = 0u;
+    for (auto& index : indices)
+    {
+      if (remap[index] == unused)
+        remap[index] = nextVertex++;
+
+      index = remap[index];
+    }
+
+    std::vector<PackedVertex> outVertices(nextVertex);
+    for (uint i = 0; i < vertices.size(); i++)
+    {
+      if (remap[i] != unused)
+        outVertices[remap[i]] = vertices[i];
+    }
+    vertices = std::move(outVertices);
+  }
+
+  //----------------------------------------------------------------------------
+  // Quadric error metric simplification.
+  //----------------------------------------------------------------------------
+  struct Quadric
+  {
+    double a00, a01, a02, a11, a12, a22;
+    double b0, b1, b2;
+    double c;
+    double weight;
+
+    Quadric()
+      : a00(0.0), a01(0.0), a02(0.0), a11(0.0), a12(0.0), a22(0.0)
+      , b0(0.0), b1(0.0), b2(0.0)
+      , c(0.0)
+      , weight(0.0)
+    { }
+
+    void add(const Quadric &other)
+    {
+      this->a00 += other.a00; this->a01 += other.a01; this->a02 += other.a02;
+      this->a11 += other.a11; this->a12 += other.a12; this->a22 += other.a22;
+      this->b0 += other.b0; this->b1 += other.b1; this->b2 += other.b2;
+      this->c += other.c;
+      this->weight += other.weight;
+    }
+
+    // Squared distance from the accumulated planes, normalized by the weight.
+    double error(const glm::dvec3 &p) const
+    {
+      const double rx = this->a00 * p.x + this->a01 * p.y + this->a02 * p.z;
+      const double ry = this->a01 * p.x + this->a11 * p.y + this->a12 * p.z;
+      const double rz = this->a02 * p.x + this->a12 * p.y + this->a22 * p.z;
+
+      double result = rx * p.x + ry * p.y + rz * p.z;
+      result += 2.0 * (this->b0 * p.x + this->b1 * p.y + this->b2 * p.z);
+      result += this->c;
+
+      return this->weight > 0.0 ? std::max(result, 0.0) / this->weight : 0.0;
+    }
+  };
+
+  Quadric
+  planeQuadric(const glm::dvec3 &normal, double d, double weight)
+  {
+    Quadric outQuadric;
+
+    outQuadric.a00 = weight * normal.x * normal.x;
+    outQuadric.a01 = weight * normal.x * normal.y;
+    outQuadric.a02 = weight * normal.x * normal.z;
+    outQuadric.a11 = weight * normal.y * normal.y;
+    outQuadric.a12 = weight * normal.y * normal.z;
+    outQuadric.a22 = weight * normal.z * normal.z;
+    outQuadric.b0 = weight * normal.x * d;
+    outQuadric.b1 = weight * normal.y * d;
+    outQuadric.b2 = weight * normal.z * d;
+    outQuadric.c = weight * d * d;
+    outQuadric.weight = weight;
+
+    return outQuadric;
+  }
+
+  float
+  simplify(std::vector<uint> &outIndices, const std::vector<uint> &indices,
+           const std::vector<PackedVertex> &vertices, uint targetIndexCount,
+           float targetError)
+  {
+    outIndices = indices;
+
+    const uint numVertices = vertices.size();
+    if (indices.size() <= targetIndexCount || numVertices == 0u)
+      return 0.0f;
+
+    // Weld vertices with identical positions into groups. Collapses operate 
+    // on groups so attribute seams don't block the whole mesh.
+    std::vector<uint> sortedVertices(numVertices);
+    std::iota(sortedVertices.begin(), sortedVertices.end(), 0u);
+    std::sort(sortedVertices.begin(), sortedVertices.end(), [&vertices](uint a, uint b)
+    {
+      const glm::vec4 &pA = vertices[a].position;
+      const glm::vec4 &pB = vertices[b].position;
+      if (pA.x != pB.x)
+        return pA.x < pB.x;
+      if (pA.y != pB.y)
+        return pA.y < pB.y;
+      return pA.z < pB.z;
+    });
+
+    std::vector<uint> groups(numVertices);
+    std::vector<uint> groupSizes;
+    std::vector<glm::dvec3> groupPositions;
+    for (uint i = 0; i < numVertices; i++)
+    {
+      const uint vertex = sortedVertices[i];
+      if (i == 0u || glm::vec3(vertices[vertex].position) != glm::vec3(vertices[sortedVertices[i - 1]].position))
+      {
+        groupSizes.push_back(0u);
+        groupPositions.emplace_back(glm::dvec3(vertices[vertex].position));
+      }
+
+      groups[vertex] = groupSizes.size() - 1u;
+      groupSizes.back()++;
+    }
+    const uint numGroups = groupSizes.size();
+
+    // Accumulate the area weighted plane quadrics.
+    std::vector<Quadric> quadrics(numGroups);
+    for (uint i = 0; i < indices.size() / 3u; i++)
+    {
+      const glm::dvec3 &p0 = groupPositions[groups[indices[3 * i]]];
+      const glm::dvec3 &p1 = groupPositions[groups[indices[3 * i + 1]]];
+      const glm::dvec3 &p2 = groupPositions[groups[indices[3 * i + 2]]];
+
+      glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+      const double area = glm::length(normal);
+      if (area <= 0.0)
+        continue;
+      normal /= area;
+
+      const Quadric plane = planeQuadric(normal, -glm::dot(normal, p0), area * 0.5);
+      for (uint j = 0; j < 3; j++)
+        quadrics[groups[indices[3 * i + j]]].add(plane);
+    }
+
+    // Lock groups which lie on attribute seams or open borders. An edge is on
+    // a border if it only has a single triangle.
+    std::vector<bool> locked(numGroups, false);
+    for (uint i = 0; i < numGroups; i++)
+      locked[i] = groupSizes[i] > 1u;
+    {
+      std::vector<std::pair<ulong, uint>> edgeCounts;
+      edgeCounts.reserve(indices.size());
+      for (uint i = 0; i < indices.size() / 3u; i++)
+      {
+        for (uint j = 0; j < 3; j++)
+        {
+          const ulong a = groups[indices[3 * i + j]];
+          const ulong b = groups[indices[3 * i + (j + 1) % 3]];
+          edgeCounts.emplace_back(a < b ? (a << 32) | b : (b << 32) | a, 1u);
+        }
+      }
+      std::sort(edgeCounts.begin(), edgeCounts.end());
+
+      for (uint i = 0; i < edgeCounts.size();)
+      {
+        uint j = i;
+        while (j < edgeCounts.size() && edgeCounts[j].first == edgeCounts[i].first)
+          j++;
+
+        if (j - i == 1u)
+        {
+          locked[edgeCounts[i].first >> 32] = true;
+          locked[edgeCounts[i].first & 0xFFFFFFFF] = true;
+        }
+
+        i = j;
+      }
+    }
+
+    const double errorLimit = static_cast<double>(targetError) * static_cast<double>(targetError);
+    double resultError = 0.0;
+
+    struct Collapse
+    {
+      uint source;
+      uint target;
+      uint targetVertex;
+      double error;
+    };
+
+    // Collapse in passes of independent edges until we hit the target.
+    while (outIndices.size() > targetIndexCount)
+    {
+      const uint numTriangles = outIndices.size() / 3u;
+
+      // Group -> triangle adjacency for the current triangles.
+      std::vector<uint> adjacencyOffsets(numGroups + 1u, 0u);
+      for (auto index : outIndices)
+        adjacencyOffsets[groups[index] + 1u]++;
+      for (uint i = 0; i < numGroups; i++)
+        adjacencyOffsets[i + 1u] += adjacencyOffsets[i];
+      std::vector<uint> adjacency(outIndices.size());
+      std::vector<uint> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+      for (uint i = 0; i < numTriangles; i++)
+      {
+        for (uint j = 0; j < 3; j++)
+          adjacency[adjacencyFill[groups[outIndices[3 * i + j]]]++] = i;
+      }
+
+      // Find the cheapest collapse for each unlocked group.
+      std::vector<Collapse> bestCollapses(numGroups, { 0u, 0u, 0u, std::numeric_limits<double>::max() });
+      for (uint i = 0; i < numTriangles; i++)
+      {
+        for (uint j = 0; j < 3; j++)
+        {
+          const uint sourceVertex = outIndices[3 * i + j];
+          const uint targetVertex = outIndices[3 * i + (j + 1) % 3];
+          const uint source = groups[sourceVertex];
+          const uint target = groups[targetVertex];
+
+          for (uint k = 0; k < 2; k++)
+          {
+            const uint from = k == 0 ? source : target;
+            const uint to = k == 0 ? target : source;
+            if (from == to || locked[from])
+              continue;
+
+            Quadric combined = quadrics[from];
+            combined.add(quadrics[to]);
+            const double error = combined.error(groupPositions[to]);
+            if (error < bestCollapses[from].error)
+              bestCollapses[from] = { from, to, k == 0 ? targetVertex : sourceVertex, error };
+          }
+        }
+      }
+
+      std::vector<Collapse> collapses;
+      for (auto& collapse : bestCollapses)
+      {
+        if (collapse.error <= errorLimit)
+          collapses.push_back(collapse);
+      }
+      std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b)
+      {
+        return a.error < b.error;
+      });
+
+      // Each collapse removes roughly two triangles.
+      const uint collapseBudget = (numTriangles - targetIndexCount / 3u) / 2u + 1u;
+
+      std::vector<bool> touched(numGroups, false);
+      std::vector<int> groupCollapses(numGroups, -1);
+      uint numCollapses = 0u;
+      for (auto& collapse : collapses)
+      {
+        if (touched[collapse.source] || touched[collapse.target])
+          continue;
+
+        // Reject collapses which would flip a triangle.
+        bool flips = false;
+        for (uint i = adjacencyOffsets[collapse.source]; i < adjacencyOffsets[collapse.source + 1u] && !flips; i++)
+        {
+          const uint triangle = adjacency[i];
+          glm::dvec3 p[3];
+          glm::dvec3 q[3];
+          bool degenerate = false;
+          for (uint j = 0; j < 3; j++)
+          {
+            const uint group = groups[outIndices[3 * triangle + j]];
+            degenerate = degenerate || group == collapse.target;
+            p[j] = groupPositions[group];
+            q[j] = group == collapse.source ? groupPositions[collapse.target] : p[j];
+          }
+
+          if (degenerate)
+            continue;
+
+          const glm::dvec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+          const glm::dvec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+          flips = glm::dot(before, after) <= 0.0;
+        }
+        if (flips)
+          continue;
+
+        // Keep the collapses of this pass independent from each other.
+        for (uint i = adjacencyOffsets[collapse.source]; i < adjacencyOffsets[collapse.source + 1u]; i++)
+        {
+          for (uint j = 0; j < 3; j++)
+            touched[groups[outIndices[3 * adjacency[i] + j]]] = true;
+        }
+
+        groupCollapses[collapse.source] = static_cast<int>(collapse.targetVertex);
+        quadrics[collapse.target].add(quadrics[collapse.source]);
+        resultError = std::max(resultError, collapse.error);
+
+        numCollapses++;
+        if (numCollapses >= collapseBudget)
+          break;
+      }
+
+      if (numCollapses == 0u)
+        break;
+
+      // Apply the collapses. Unlocked groups only have a single vertex, so 
+      // the source vertex is replaced with the vertex on the collapsed edge.
+      std::vector<uint> newIndices;
+      newIndices.reserve(outIndices.size());
+      for (uint i = 0; i < numTriangles; i++)
+      {
+        uint triangle[3];
+        for (uint j = 0; j < 3; j++)
+        {
+          const uint vertex = outIndices[3 * i + j];
+          const int collapse = groupCollapses[groups[vertex]];
+          triangle[j] = collapse >= 0 ? static_cast<uint>(collapse) : vertex;
+        }
+
+        if (groups[triangle[0]] == groups[triangle[1]] || groups[triangle[1]] == groups[triangle[2]]
+            || groups[triangle[0]] == groups[triangle[2]])
+          continue;
+
+        newIndices.insert(newIndices.end(), triangle, triangle + 3);
+      }
+      outIndices = std::move(newIndices);
+    }
+
+    return static_cast<float>(std::sqrt(resultError));
+  }
+
+  MeshOptimizationStatistics
+  optimizeMesh(std::vector<PackedVertex> &vertices, std::vector<uint> &indices)
+  {
+    MeshOptimizationStatistics outStats;
+
+    outStats.before = analyzeVertexCache(indices, vertices.size());
+
+    optimizeVertexCache(indices, vertices.size());
+    outStats.numClusters = optimizeOverdraw(indices, vertices);
+    optimizeVertexFetch(vertices, indices);
+
+    outStats.after = analyzeVertexCache(indices, vertices.size());
+
+    return outStats;
+  }
+}
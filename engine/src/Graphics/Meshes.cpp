@@ -11,12 +11,15 @@ namespace Strontium
     : loaded(false)
     , skinned(false)
     , drawable(false)
+    , optimized(false)
     , name(name)
     , parent(parent)
     , maxPos(std::numeric_limits<float>::min())
     , minPos(std::numeric_limits<float>::max())
     , localTransform(1.0f)
     , globalBufferLocation(0u)
+    , globalVertexLocation(0u)
+    , globalMeshletLocation(0u)
   { }
 
   Mesh::Mesh(const std::string &name, const std::vector<PackedVertex> &vertices,
@@ -24,9 +27,12 @@ namespace Strontium
     : loaded(true)
     , skinned(false)
     , drawable(false)
+    , optimized(false)
     , data(vertices)
     , indices(indices)
     , globalBufferLocation(0u)
+    , globalVertexLocation(0u)
+    , globalMeshletLocation(0u)
     , name(name)
     , parent(parent)
     , maxPos(std::numeric_limits<float>::min())
@@ -51,4 +57,95 @@ namespace Strontium
     
     return success;
   }
+
+  void
+  Mesh::setGlobalLocation(uint globalLocation, uint lod)
+  {
+    if (lod == 0u)
+      this->globalBufferLocation = globalLocation;
+    else
+      this->lods[lod - 1u].globalBufferLocation = globalLocation;
+  }
+
+  void
+  Mesh::optimize()
+  {
+    if (!this->loaded || this->drawable || this->optimized)
+      return;
+
+    this->optimizationStats = MeshOptimization::optimizeMesh(this->data, this->indices);
+    this->optimized = true;
+  }
+
+  void
+  Mesh::generateMeshlets()
+  {
+    if (!this->loaded || this->drawable)
+      return;
+
+    this->meshlets = Meshlets::buildMeshlets(this->indices, this->data);
+  }
+
+  // Generate a chain of LODs, each with roughly half of the triangles of the
+  // previous one. Stops early if the mesh can't be simplified any further.
+  void
+  Mesh::generateLODs()
+  {
+    if (!this->loaded || this->drawable)
+      return;
+
+    const float meshRadius = 0.5f * glm::length(this->maxPos - this->minPos);
+
+    this->lods.clear();
+    this->lods.reserve(MAX_MESH_LODS - 1u);
+    for (uint i = 1; i < MAX_MESH_LODS; i++)
+    {
+      const auto& source = this->getIndices(i - 1u);
+      const uint targetIndexCount = ((source.size() / 3u) / 2u) * 3u;
+      if (targetIndexCount < 3u * 32u)
+        break;
+
+      MeshLOD lod;
+      const float error = MeshOptimization::simplify(lod.indices, source, this->data,
+                                                     targetIndexCount, 0.1f * meshRadius);
+
+      // Not worth storing a LOD which barely removed anything.
+      if (lod.indices.size() * 10u > source.size() * 9u)
+        break;
+
+      MeshOptimization::optimizeVertexCache(lod.indices, this->data.size());
+      lod.error = this->getLODError(i - 1u) + error;
+
+      this->lods.emplace_back(std::move(lod));
+    }
+  }
+
+  // Pick the coarsest LOD whose error projects to less than maxPixelError 
+  // pixels. The previous LOD is kept while the error is within the hysteresis 
+  // band to stop LODs from popping back and forth.
+  uint
+  Mesh::selectLOD(float pixelsPerUnit, float maxPixelError, float hysteresis,
+                  uint previousLOD) const
+  {
+    const uint numLODs = this->numLODs();
+    if (numLODs == 1u)
+      return 0u;
+    previousLOD = glm::min(previousLOD, numLODs - 1u);
+
+    uint coarsen = 0u;
+    uint refine = 0u;
+    for (uint i = 1; i < numLODs; i++)
+    {
+      const float projectedError = this->getLODError(i) * pixelsPerUnit;
+      if (projectedError <= maxPixelError * (1.0f - hysteresis))
+        coarsen = i;
+      if (projectedError <= maxPixelError * (1.0f + hysteresis))
+        refine = i;
+    }
+
+    if (previousLOD >= coarsen && previousLOD <= refine)
+      return previousLOD;
+
+    return previousLOD < coarsen ? coarsen : refine;
+  }
 }
@@ -0,0 +1,160 @@
+#include "Graphics/Meshlets.h"
+
+// Project includes.
+#include "Graphics/Meshes.h"
+
+namespace Strontium::Meshlets
+{
+  void
+  computeMeshletBounds(Meshlet &meshlet, const std::vector<uint> &indices,
+                       const std::vector<PackedVertex> &vertices)
+  {
+    // Bounding sphere centered on the AABB of the meshlet.
+    glm::vec3 minPos = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 maxPos = glm::vec3(-std::numeric_limits<float>::max());
+    for (uint i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.numIndices; i++)
+    {
+      minPos = glm::min(minPos, glm::vec3(vertices[indices[i]].position));
+      maxPos = glm::max(maxPos, glm::vec3(vertices[indices[i]].position));
+    }
+    meshlet.center = 0.5f * (minPos + maxPos);
+
+    meshlet.radius = 0.0f;
+    for (uint i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.numIndices; i++)
+      meshlet.radius = glm::max(meshlet.radius, glm::length(glm::vec3(vertices[indices[i]].position) - meshlet.center));
+
+    // Normal cone from the triangle normals.
+    std::vector<glm::vec3> normals;
+    normals.reserve(meshlet.numIndices / 3u);
+    glm::vec3 axis = glm::vec3(0.0f);
+    for (uint i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.numIndices; i += 3)
+    {
+      const glm::vec3 p0 = glm::vec3(vertices[indices[i]].position);
+      const glm::vec3 p1 = glm::vec3(vertices[indices[i + 1]].position);
+      const glm::vec3 p2 = glm::vec3(vertices[indices[i + 2]].position);
+
+      const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+      const float area = glm::length(normal);
+      if (area <= 0.0f)
+        continue;
+
+      normals.emplace_back(normal / area);
+      axis += normals.back();
+    }
+
+    const float axisLength = glm::length(axis);
+    if (normals.empty() || axisLength <= 0.0f)
+      return;
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (auto& normal : normals)
+      minDot = glm::min(minDot, glm::dot(axis, normal));
+
+    // The normals span more than a hemisphere, can't cone cull this one.
+    if (minDot <= 0.0f)
+      return;
+
+    meshlet.coneAxis = axis;
+    meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+  }
+
+  std::vector<Meshlet>
+  buildMeshlets(const std::vector<uint> &indices, const std::vector<PackedVertex> &vertices,
+                uint maxVertices, uint maxTriangles)
+  {
+    std::vector<Meshlet> outMeshlets;
+    if (indices.size() < 3u)
+      return outMeshlets;
+
+    // Tracks which meshlet last used a vertex to count unique vertices.
+    std::vector<uint> vertexMeshlet(vertices.size(), std::numeric_limits<uint>::max());
+
+    outMeshlets.emplace_back();
+    for (uint i = 0; i < indices.size(); i += 3)
+    {
+      Meshlet* current = &outMeshlets.back();
+      const uint meshletIndex = outMeshlets.size() - 1u;
+
+      uint newVertices = 0u;
+      for (uint j = 0; j < 3; j++)
+        newVertices += vertexMeshlet[indices[i + j]] != meshletIndex ? 1u : 0u;
+
+      // Start a new meshlet if this triangle doesn't fit.
+      if (current->numVertices + newVertices > maxVertices || current->numIndices / 3u + 1u > maxTriangles)
+      {
+        computeMeshletBounds(*current, indices, vertices);
+
+        outMeshlets.emplace_back();
+        current = &outMeshlets.back();
+        current->firstIndex = i;
+        newVertices = 3u;
+      }
+
+      const uint currentIndex = outMeshlets.size() - 1u;
+      for (uint j = 0; j < 3; j++)
+      {
+        if (vertexMeshlet[indices[i + j]] != currentIndex)
+        {
+          vertexMeshlet[indices[i + j]] = currentIndex;
+          current->numVertices++;
+        }
+      }
+      current->numIndices += 3u;
+    }
+    computeMeshletBounds(outMeshlets.back(), indices, vertices);
+
+    return outMeshlets;
+  }
+
+  bool
+  meshletVisible(const Meshlet &meshlet, const glm::mat4 &transform,
+                 const glm::mat3 &normalMatrix, float scale,
+                 const Frustum &frustum, const glm::vec3 &cameraPosition)
+  {
+    const glm::vec3 center = glm::vec3(transform * glm::vec4(meshlet.center, 1.0f));
+    const float radius = meshlet.radius * scale;
+
+    if (!sphereInFrustum(frustum, center, radius))
+      return false;
+
+    if (meshlet.coneCutoff > 1.0f)
+      return true;
+
+    // Backfacing cone test against the bounding sphere.
+    const glm::vec3 axis = glm::normalize(normalMatrix * meshlet.coneAxis);
+    const glm::vec3 view = center - cameraPosition;
+    return glm::dot(view, axis) < meshlet.coneCutoff * glm::length(view) + radius;
+  }
+
+  uint
+  cullMeshlets(const std::vector<Meshlet> &meshlets, const glm::mat4 &transform,
+               const Frustum &frustum, const glm::vec3 &cameraPosition,
+               uint globalFirstIndex, uint baseInstance,
+               std::vector<DrawArraysIndirectCommand> &outCommands)
+  {
+    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+    const float scale = glm::max(glm::length(glm::vec3(transform[0])),
+                                 glm::max(glm::length(glm::vec3(transform[1])),
+                                          glm::length(glm::vec3(transform[2]))));
+
+    const uint firstCommand = outCommands.size();
+    uint numVisible = 0u;
+    for (auto& meshlet : meshlets)
+    {
+      if (!meshletVisible(meshlet, transform, normalMatrix, scale, frustum, cameraPosition))
+        continue;
+
+      // Merge with the previous command if the ranges are adjacent.
+      const uint first = globalFirstIndex + meshlet.firstIndex;
+      if (outCommands.size() > firstCommand && outCommands.back().first + outCommands.back().count == first)
+        outCommands.back().count += meshlet.numIndices;
+      else
+        outCommands.emplace_back(meshlet.numIndices, 1u, first, baseInstance);
+
+      numVisible++;
+    }
+
+    return numVisible;
+  }
+}
@@ -4,6 +4,7 @@
 #include "Core/Logs.h"
 #include "Core/Events.h"
 #include "Core/Math.h"
+#include "Core/JobSystem.h"
 #include "Utils/AssimpUtilities.h"
 #include "Graphics/Renderer.h"
 
@@ -88,11 +89,15 @@ namespace Strontium
     this->processNode(scene->mRootNode, scene, filepath.parent_path().string(), 
                       glm::mat4(1.0f), isGLTF);
 
+    // Optimize the submeshes for the post-transform cache and overdraw, and
+    // generate their LODs.
+    this->optimizeSubmeshes();
+
     // Load in animations.
     if (scene->HasAnimations())
     {
       for (unsigned int i = 0; i < scene->mNumAnimations; i++)
-        this->storedAnimations.emplace_back(scene->mAnimations[i], this);
+        this->storedAnimations.emplace_back(scene->mAnimations[i], this, filepath.string(), i);
     }
 
     this->loaded = true;
@@ -354,6 +359,56 @@ namespace Strontium
     this->subMeshes.back().setLoaded(true);
   }
 
+  // Optimize each submesh and generate its LOD chain in parallel. This is only
+  // done once at import time, the optimized data is what gets added to the 
+  // global geometry cache.
+  void
+  Model::optimizeSubmeshes()
+  {
+    std::vector<std::future<void>> optimizationJobs;
+    optimizationJobs.reserve(this->subMeshes.size());
+    for (auto& submesh : this->subMeshes)
+    {
+      Mesh* mesh = &submesh;
+      optimizationJobs.emplace_back(JobSystem::push([mesh]()
+      {
+        mesh->optimize();
+        mesh->generateLODs();
+        mesh->generateMeshlets();
+      }));
+    }
+
+    // Help out with the queue while waiting, this may be called from a job.
+    for (auto& job : optimizationJobs)
+      JobSystem::wait(job);
+
+    VertexCacheStatistics before, after;
+    uint numTriangles = 0u, numVertices = 0u;
+    for (auto& submesh : this->subMeshes)
+    {
+      if (!submesh.isOptimized())
+        continue;
+
+      auto& stats = submesh.getOptimizationStats();
+      before.numVerticesTransformed += stats.before.numVerticesTransformed;
+      after.numVerticesTransformed += stats.after.numVerticesTransformed;
+      numTriangles += submesh.numToRender() / 3u;
+      numVertices += submesh.numVertices();
+    }
+
+    if (numTriangles == 0u || numVertices == 0u)
+      return;
+
+    before.acmr = static_cast<float>(before.numVerticesTransformed) / static_cast<float>(numTriangles);
+    before.atvr = static_cast<float>(before.numVerticesTransformed) / static_cast<float>(numVertices);
+    after.acmr = static_cast<float>(after.numVerticesTransformed) / static_cast<float>(numTriangles);
+    after.atvr = static_cast<float>(after.numVerticesTransformed) / static_cast<float>(numVertices);
+
+    Logs::log("Optimized " + std::to_string(this->subMeshes.size()) + " submesh(es). ACMR: " 
+              + std::to_string(before.acmr) + " -> " + std::to_string(after.acmr) + ", ATVR: " 
+              + std::to_string(before.atvr) + " -> " + std::to_string(after.atvr) + ".");
+  }
+
   void
   Model::addBoneData(unsigned int boneIndex, float boneWeight, PackedVertex &toMod)
   {
@@ -374,9 +429,11 @@ namespace Strontium
   {
     if (this->loaded && !this->drawable)
     {
+      // The index count includes every LOD since they all live in the cache.
       for (auto& mesh : this->subMeshes)
       {
-        this->totalNumIndices += mesh.numToRender();
+        for (uint i = 0; i < mesh.numLODs(); i++)
+          this->totalNumIndices += mesh.numToRender(i);
         this->totalNumVerts += mesh.numVertices();
       }
       Renderer3D::addModelToCache(*this);